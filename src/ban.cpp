@@ -20,43 +20,81 @@
 #include "otpch.h"
 
 #include "ban.h"
+#include "configmanager.h"
 #include "database.h"
 #include "databasetasks.h"
 #include "tools.h"
 
 #include <fmt/format.h>
 
-bool Ban::acceptConnection(uint32_t clientIP)
+extern ConfigManager g_config;
+
+namespace {
+
+int64_t getMicroseconds()
 {
-	std::lock_guard<std::recursive_mutex> lockClass(lock);
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
-	uint64_t currentTime = OTSYS_TIME();
+}
 
-	auto it = ipConnectMap.find(clientIP);
-	if (it == ipConnectMap.end()) {
-		ipConnectMap.emplace(clientIP, ConnectBlock(currentTime, 0, 1));
+bool Ban::acceptConnection(uint32_t clientIP)
+{
+	int64_t rate = g_config.getNumber(ConfigManager::IP_CONNECTIONS_PER_SECOND);
+	if (rate <= 0) {
 		return true;
 	}
 
-	ConnectBlock& connectBlock = it->second;
-	if (connectBlock.blockTime > currentTime) {
-		connectBlock.blockTime += 250;
-		return false;
-	}
+	int64_t interval = 1000000 / rate;
+	int64_t tolerance = interval * (std::max<int64_t>(1, g_config.getNumber(ConfigManager::IP_CONNECTION_BURST)) - 1);
+	int64_t now = getMicroseconds();
 
-	int64_t timeDiff = currentTime - connectBlock.lastAttempt;
-	connectBlock.lastAttempt = currentTime;
-	if (timeDiff <= 5000) {
-		if (++connectBlock.count > 5) {
-			connectBlock.count = 0;
-			if (timeDiff <= 500) {
-				connectBlock.blockTime = currentTime + 3000;
-				return false;
+	IpShard& shard = ipShards[(clientIP * 2654435761u) >> 28];
+	std::lock_guard<std::mutex> lockClass(shard.lock);
+
+	if (now - shard.lastPrune >= 1000000) {
+		for (auto it = shard.arrivals.begin(); it != shard.arrivals.end(); ) {
+			if (it->second <= now) {
+				it = shard.arrivals.erase(it);
+			} else {
+				++it;
 			}
 		}
-	} else {
-		connectBlock.count = 1;
+		shard.lastPrune = now;
 	}
+
+	int64_t& arrival = shard.arrivals[clientIP];
+	int64_t nextArrival = std::max(arrival, now);
+	if (nextArrival - now > tolerance) {
+		++rejectedByIp;
+		return false;
+	}
+
+	arrival = nextArrival + interval;
+	return true;
+}
+
+bool Ban::acceptNewConnection()
+{
+	int64_t rate = g_config.getNumber(ConfigManager::MAX_NEW_CONNECTIONS_PER_SECOND);
+	if (rate <= 0) {
+		return true;
+	}
+
+	// one second worth of connections may arrive at once
+	int64_t interval = 1000000 / rate;
+	int64_t tolerance = interval * (rate - 1);
+	int64_t now = getMicroseconds();
+
+	int64_t arrival = globalArrival.load(std::memory_order_relaxed);
+	int64_t nextArrival;
+	do {
+		nextArrival = std::max(arrival, now);
+		if (nextArrival - now > tolerance) {
+			++rejectedGlobally;
+			return false;
+		}
+	} while (!globalArrival.compare_exchange_weak(arrival, nextArrival + interval, std::memory_order_relaxed));
 	return true;
 }
 
@@ -26,25 +26,31 @@ struct BanInfo {
 	time_t expiresAt;
 };
 
-struct ConnectBlock {
-	constexpr ConnectBlock(uint64_t lastAttempt, uint64_t blockTime, uint32_t count) :
-		lastAttempt(lastAttempt), blockTime(blockTime), count(count) {}
-
-	uint64_t lastAttempt;
-	uint64_t blockTime;
-	uint32_t count;
-};
-
-using IpConnectMap = std::map<uint32_t, ConnectBlock>;
-
+// Connection admission through token buckets, kept as the theoretical arrival time of the
+// next connection (GCRA) in microseconds: one bucket per IP and one for every new connection
 class Ban
 {
 	public:
+		// per IP limit, checked on accept and again for the real IP behind a proxy
 		bool acceptConnection(uint32_t clientIP);
+		// global limit of new connections per second, checked once on accept after the per IP limit
+		bool acceptNewConnection();
+
+		std::atomic<uint32_t> rejectedByIp{0};
+		std::atomic<uint32_t> rejectedGlobally{0};
 
 	private:
-		IpConnectMap ipConnectMap;
-		std::recursive_mutex lock;
+		// IPs are sharded to keep accepts on different addresses from contending,
+		// an IP whose bucket refilled is dropped on the next prune of its shard
+		static constexpr size_t IP_SHARDS = 16;
+		struct IpShard {
+			std::mutex lock;
+			std::unordered_map<uint32_t, int64_t> arrivals;
+			int64_t lastPrune = 0;
+		};
+
+		std::array<IpShard, IP_SHARDS> ipShards;
+		std::atomic<int64_t> globalArrival{0};
 };
 
 class IOBan
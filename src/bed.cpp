@@ -285,4 +285,5 @@ void BedItem::internalRemoveSleeper()
 	if (hasAttribute(ITEM_ATTRIBUTE_DESCRIPTION)) {
 		removeAttribute(ITEM_ATTRIBUTE_DESCRIPTION);
 	}
+	invalidateTileCaches();
 }
@@ -1250,6 +1250,74 @@ void ConditionDamage::serialize(PropWriteStream& propWriteStream)
 	}
 }
 
+void ConditionDamage::serializeDefinition(PropWriteStream& propWriteStream) const
+{
+	propWriteStream.write<ConditionId_t>(getId());
+	propWriteStream.write<ConditionType_t>(conditionType);
+	propWriteStream.write<int64_t>(endTime);
+	propWriteStream.write<uint32_t>(subId);
+	propWriteStream.write<int32_t>(ticks);
+	propWriteStream.write<bool>(isBuff);
+	propWriteStream.write<bool>(aggressive);
+
+	propWriteStream.write<int32_t>(maxDamage);
+	propWriteStream.write<int32_t>(minDamage);
+	propWriteStream.write<int32_t>(startDamage);
+	propWriteStream.write<int32_t>(periodDamage);
+	propWriteStream.write<int32_t>(periodDamageTick);
+	propWriteStream.write<int32_t>(tickInterval);
+	propWriteStream.write<int32_t>(initDamage);
+	propWriteStream.write<int32_t>(cycle);
+	propWriteStream.write<int32_t>(minCycle);
+	propWriteStream.write<int32_t>(count);
+	propWriteStream.write<int32_t>(maxCount);
+	propWriteStream.write<int32_t>(factorPercent);
+	propWriteStream.write<bool>(forceUpdate);
+	propWriteStream.write<bool>(delayed);
+	propWriteStream.write<bool>(field);
+	propWriteStream.write<uint32_t>(owner);
+	propWriteStream.write<uint32_t>(ownerGuid);
+
+	propWriteStream.write<uint32_t>(damageList.size());
+	for (const IntervalInfo& intervalInfo : damageList) {
+		propWriteStream.write<IntervalInfo>(intervalInfo);
+	}
+}
+
+ConditionDamage* ConditionDamage::unserializeDefinition(PropStream& propStream)
+{
+	ConditionId_t id;
+	ConditionType_t type;
+	if (!propStream.read<ConditionId_t>(id) || !propStream.read<ConditionType_t>(type)) {
+		return nullptr;
+	}
+
+	std::unique_ptr<ConditionDamage> condition(new ConditionDamage(id, type));
+	uint32_t intervals;
+	if (!propStream.read<int64_t>(condition->endTime) || !propStream.read<uint32_t>(condition->subId) || !propStream.read<int32_t>(condition->ticks) ||
+	        !propStream.read<bool>(condition->isBuff) || !propStream.read<bool>(condition->aggressive) ||
+	        !propStream.read<int32_t>(condition->maxDamage) || !propStream.read<int32_t>(condition->minDamage) ||
+	        !propStream.read<int32_t>(condition->startDamage) || !propStream.read<int32_t>(condition->periodDamage) ||
+	        !propStream.read<int32_t>(condition->periodDamageTick) || !propStream.read<int32_t>(condition->tickInterval) ||
+	        !propStream.read<int32_t>(condition->initDamage) || !propStream.read<int32_t>(condition->cycle) ||
+	        !propStream.read<int32_t>(condition->minCycle) || !propStream.read<int32_t>(condition->count) ||
+	        !propStream.read<int32_t>(condition->maxCount) || !propStream.read<int32_t>(condition->factorPercent) ||
+	        !propStream.read<bool>(condition->forceUpdate) || !propStream.read<bool>(condition->delayed) ||
+	        !propStream.read<bool>(condition->field) || !propStream.read<uint32_t>(condition->owner) ||
+	        !propStream.read<uint32_t>(condition->ownerGuid) || !propStream.read<uint32_t>(intervals)) {
+		return nullptr;
+	}
+
+	for (uint32_t i = 0; i < intervals; ++i) {
+		IntervalInfo intervalInfo;
+		if (!propStream.read<IntervalInfo>(intervalInfo)) {
+			return nullptr;
+		}
+		condition->damageList.push_back(intervalInfo);
+	}
+	return condition.release();
+}
+
 bool ConditionDamage::updateCondition(const Condition* addCondition)
 {
 	const ConditionDamage& conditionDamage = static_cast<const ConditionDamage&>(*addCondition);
@@ -305,6 +305,10 @@ class ConditionDamage final : public Condition
 		void serialize(PropWriteStream& propWriteStream) override;
 		bool unserializeProp(ConditionAttr_t attr, PropStream& propStream) override;
 
+		// complete definition, unlike serialize() which only keeps the running state
+		void serializeDefinition(PropWriteStream& propWriteStream) const;
+		static ConditionDamage* unserializeDefinition(PropStream& propStream);
+
 	private:
 		int32_t maxDamage = 0;
 		int32_t minDamage = 0;
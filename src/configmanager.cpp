@@ -246,6 +246,7 @@ bool ConfigManager::load()
 	boolean[HOUSES_ONLY_PREMIUM] = getGlobalBoolean(L, "housesOnlyPremium", true);
 	boolean[UPON_MAP_UPDATE_SENDPLAYERS_TO_TEMPLE] = getGlobalBoolean(L, "uponMapUpdateSendPlayersToTemple", true);
 	boolean[GAMEMASTER_DAMAGEPROTECTONZONEEFFECTS] = getGlobalBoolean(L, "gamemasterDamageProtectOnZoneEffects", false);
+	boolean[PACKET_COMPRESSION] = getGlobalBoolean(L, "packetCompression", false);
 
 	string[DEFAULT_PRIORITY] = getGlobalString(L, "defaultPriority", "high");
 	string[SERVER_NAME] = getGlobalString(L, "serverName", "");
@@ -261,6 +262,7 @@ bool ConfigManager::load()
 	string[ACCOUNT_LOCK_MESSAGE] = getGlobalString(L, "accountLockMessage", "Account disabled for five minutes. Please wait.");
 	string[LOG_PATH] = getGlobalString(L, "logPath", "/data/gamedata/logs/");
 	string[BATTLEPASS_END_DATE] = getGlobalString(L, "battlePassEndDate", "");
+	string[CONNECTION_BACKPRESSURE_POLICY] = getGlobalString(L, "connectionBackpressurePolicy", "drop");
 
 	integer[CLIENT_VERSION] = getGlobalNumber(L, "clientVersion");
 	integer[MAX_PLAYERS] = getGlobalNumber(L, "maxPlayers");
@@ -311,6 +313,16 @@ bool ConfigManager::load()
 	integer[STATS_VERY_SLOW_LOG_TIME] = getGlobalNumber(L, "statsVerySlowLogTime", 50);
 
 	integer[BESTIARY_KILL_COUNT] = getGlobalNumber(L, "bestiaryKillCount", 1);
+	integer[PACKET_COMPRESSION_LEVEL] = getGlobalNumber(L, "packetCompressionLevel", 6);
+	integer[PACKET_COMPRESSION_MIN_SIZE] = getGlobalNumber(L, "packetCompressionMinSize", 128);
+	integer[OUTPUT_COALESCING_WINDOW] = getGlobalNumber(L, "outputCoalescingWindow", 10);
+	integer[MAX_CONNECTION_QUEUE_MESSAGES] = getGlobalNumber(L, "maxConnectionQueueMessages", 256);
+	integer[MAX_CONNECTION_QUEUE_BYTES] = getGlobalNumber(L, "maxConnectionQueueBytes", 1024 * 1024);
+	integer[RSA_WORKER_THREADS] = getGlobalNumber(L, "rsaWorkerThreads", 2);
+	integer[STATUS_CACHE_INTERVAL] = getGlobalNumber(L, "statusCacheInterval", 5000);
+	integer[IP_CONNECTIONS_PER_SECOND] = getGlobalNumber(L, "ipConnectionsPerSecond", 2);
+	integer[IP_CONNECTION_BURST] = getGlobalNumber(L, "ipConnectionBurst", 6);
+	integer[MAX_NEW_CONNECTIONS_PER_SECOND] = getGlobalNumber(L, "maxNewConnectionsPerSecond", 200);
 	expStages = loadXMLStages();
 
 	expStages.shrink_to_fit();
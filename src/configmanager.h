@@ -86,6 +86,7 @@ class ConfigManager
 			HOUSES_ONLY_PREMIUM,
 			UPON_MAP_UPDATE_SENDPLAYERS_TO_TEMPLE,
 			GAMEMASTER_DAMAGEPROTECTONZONEEFFECTS,
+			PACKET_COMPRESSION,
 
 			LAST_BOOLEAN_CONFIG /* this must be the last one */
 		};
@@ -117,6 +118,7 @@ class ConfigManager
 			IP_LOCK_MESSAGE,
 			LOG_PATH,
 			BATTLEPASS_END_DATE,
+			CONNECTION_BACKPRESSURE_POLICY,
 
 			LAST_STRING_CONFIG /* this must be the last one */
 		};
@@ -180,6 +182,16 @@ class ConfigManager
 			STATS_VERY_SLOW_LOG_TIME,
 
 			BESTIARY_KILL_COUNT,
+			PACKET_COMPRESSION_LEVEL,
+			PACKET_COMPRESSION_MIN_SIZE,
+			OUTPUT_COALESCING_WINDOW,
+			MAX_CONNECTION_QUEUE_MESSAGES,
+			MAX_CONNECTION_QUEUE_BYTES,
+			RSA_WORKER_THREADS,
+			STATUS_CACHE_INTERVAL,
+			IP_CONNECTIONS_PER_SECOND,
+			IP_CONNECTION_BURST,
+			MAX_NEW_CONNECTIONS_PER_SECOND,
 			LAST_INTEGER_CONFIG /* this must be the last one */
 		};
 
@@ -15,11 +15,12 @@
 extern ConfigManager g_config;
 extern Ban g_bans;
 
-Connection_ptr ConnectionManager::createConnection(boost::asio::io_service& io_service, ConstServicePort_ptr servicePort)
+Connection_ptr ConnectionManager::createConnection(boost::asio::io_service& io_service, ConstServicePort_ptr servicePort, boost::asio::ip::tcp::socket socket)
 {
 	std::lock_guard<std::mutex> lockClass(connectionManagerLock);
 
-	auto connection = std::make_shared<Connection>(io_service, servicePort);
+	auto connection = std::make_shared<Connection>(io_service, servicePort, std::move(socket));
+	connection->disconnectOnBackpressure = g_config.getString(ConfigManager::CONNECTION_BACKPRESSURE_POLICY) == "disconnect";
 	connections.insert(connection);
 	return connection;
 }
@@ -88,6 +89,7 @@ void Connection::closeSocket()
 
 Connection::~Connection()
 {
+	setBackpressured(false);
 	closeSocket();
 }
 
@@ -108,7 +110,7 @@ void Connection::accept()
 
 		// Read size of the first packet
 		boost::asio::async_read(socket,
-		                        boost::asio::buffer(msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
+		                        boost::asio::buffer(msg->getBuffer(), NetworkMessage::HEADER_LENGTH),
 		                        std::bind(&Connection::parseHeader, shared_from_this(), std::placeholders::_1));
 	} catch (boost::system::system_error& e) {
 		std::cout << "[Network error - Connection::accept] " << e.what() << std::endl;
@@ -140,7 +142,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 		packetsSent = 0;
 	}
 
-	uint16_t size = msg.getLengthHeader();
+	uint16_t size = msg->getLengthHeader();
 	// only the first packet may contain the proxy identification
 	if (!receivedFirstHeader) {
 		receivedFirstHeader = true;
@@ -151,7 +153,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 			readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
 			readTimer.async_wait(std::bind(&Connection::handleTimeout, std::weak_ptr<Connection>(shared_from_this()), std::placeholders::_1));
 
-			boost::asio::async_read(socket, boost::asio::buffer(msg.getBuffer(), 4), [&, self](const boost::system::error_code& errorCode, size_t) {
+			boost::asio::async_read(socket, boost::asio::buffer(msg->getBuffer(), 4), [&, self](const boost::system::error_code& errorCode, size_t) {
 				std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 				readTimer.cancel();
 				if (errorCode) {
@@ -160,7 +162,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 					close(FORCE_CLOSE);
 					return;
 				}
-				uint8_t* msgBuffer = msg.getBuffer();
+				uint8_t* msgBuffer = msg->getBuffer();
 				realIP = *(uint32_t*)msgBuffer;
 				otcProxy = true;
 				if (!g_bans.acceptConnection(realIP)) {
@@ -178,7 +180,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 			readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
 			readTimer.async_wait(std::bind(&Connection::handleTimeout, std::weak_ptr<Connection>(shared_from_this()), std::placeholders::_1));
 
-			boost::asio::async_read(socket, boost::asio::buffer(msg.getBuffer(), 26), [&, self](const boost::system::error_code& errorCode, size_t) {
+			boost::asio::async_read(socket, boost::asio::buffer(msg->getBuffer(), 26), [&, self](const boost::system::error_code& errorCode, size_t) {
 				std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 				readTimer.cancel();
 				if (errorCode) {
@@ -187,7 +189,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 					close(FORCE_CLOSE);
 					return;
 				}
-				uint8_t* msgBuffer = msg.getBuffer();
+				uint8_t* msgBuffer = msg->getBuffer();
 				realIP = *(uint32_t*)&msgBuffer[14];
 				haProxy = true;
 
@@ -199,11 +201,6 @@ void Connection::parseHeader(const boost::system::error_code& error)
 				accept();
 				});
 			return;
-		} else {
-			if (!g_bans.acceptConnection(getIP())) {
-				close(FORCE_CLOSE);
-				return;
-			}
 		}
 	}
 
@@ -218,8 +215,8 @@ void Connection::parseHeader(const boost::system::error_code& error)
 		                                    std::placeholders::_1));
 
 		// Read packet content
-		msg.setLength(size + NetworkMessage::HEADER_LENGTH);
-		boost::asio::async_read(socket, boost::asio::buffer(msg.getBodyBuffer(), size),
+		msg->setLength(size + NetworkMessage::HEADER_LENGTH);
+		boost::asio::async_read(socket, boost::asio::buffer(msg->getBodyBuffer(), size),
 		                        std::bind(&Connection::parsePacket, shared_from_this(), std::placeholders::_1));
 	} catch (boost::system::system_error& e) {
 		std::cout << "[Network error - Connection::parseHeader] " << e.what() << std::endl;
@@ -245,18 +242,25 @@ void Connection::parsePacket(const boost::system::error_code& error)
 
 		if (!protocol) {
 			// Game protocol has already been created at this point
-			protocol = service_port->make_protocol(msg, shared_from_this());
+			protocol = service_port->make_protocol(*msg, shared_from_this());
 			if (!protocol) {
 				close(FORCE_CLOSE);
 				return;
 			}
 		} else {
-			msg.skipBytes(1); // Skip protocol ID
+			msg->skipBytes(1); // Skip protocol ID
 		}
 
-		protocol->onRecvFirstMessage(msg);
+		protocol->onRecvFirstMessage(*msg);
+		if (readSuspended) {
+			return;
+		}
 	} else {
 		protocol->onRecvMessage(msg); // Send the packet to the current protocol
+		if (msg.use_count() != 1) {
+			// the packet is queued on the dispatcher, read the next one into another buffer
+			msg = NetworkMessagePool::getMessage();
+		}
 	}
 
 	try {
@@ -266,7 +270,7 @@ void Connection::parsePacket(const boost::system::error_code& error)
 
 		// Wait to the next packet
 		boost::asio::async_read(socket,
-		                        boost::asio::buffer(msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
+		                        boost::asio::buffer(msg->getBuffer(), NetworkMessage::HEADER_LENGTH),
 		                        std::bind(&Connection::parseHeader, shared_from_this(), std::placeholders::_1));
 	} catch (boost::system::system_error& e) {
 		std::cout << "[Network error - Connection::parsePacket] " << e.what() << std::endl;
@@ -274,6 +278,29 @@ void Connection::parsePacket(const boost::system::error_code& error)
 	}
 }
 
+void Connection::suspendRead()
+{
+	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
+	readSuspended = true;
+}
+
+void Connection::resumeRead(std::function<void(void)> callback)
+{
+	boost::asio::post(socket.get_executor(), [thisPtr = shared_from_this(), callback = std::move(callback)]() {
+		std::lock_guard<std::recursive_mutex> lockClass(thisPtr->connectionLock);
+		if (thisPtr->closed) {
+			return;
+		}
+
+		callback();
+
+		thisPtr->readSuspended = false;
+		if (!thisPtr->closed) {
+			thisPtr->accept();
+		}
+	});
+}
+
 void Connection::send(const OutputMessage_ptr& msg)
 {
 	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
@@ -283,13 +310,58 @@ void Connection::send(const OutputMessage_ptr& msg)
 
 	bool noPendingWrite = messageQueue.empty();
 	messageQueue.emplace_back(msg);
+	queuedMessages++;
+	queuedBytes += msg->getLength();
+
+	if (!checkBackpressure()) {
+		return;
+	}
+
 	if (noPendingWrite) {
 		internalSend(msg);
 	}
 }
 
+bool Connection::checkBackpressure()
+{
+	auto& manager = ConnectionManager::getInstance();
+	manager.queueDepthSamples[std::min<size_t>(queuedMessages, ConnectionManager::QUEUE_DEPTH_BUCKETS - 1)]++;
+
+	if (queuedMessages <= getMaxQueuedMessages() && queuedBytes <= getMaxQueuedBytes()) {
+		return true;
+	}
+
+	// dropping non-critical packets only slows the growth, past the hard limit the client is not keeping up at all
+	const bool overHardLimit = queuedMessages > getMaxQueuedMessages() * CONNECTION_QUEUE_HARD_LIMIT_FACTOR ||
+		queuedBytes > getMaxQueuedBytes() * CONNECTION_QUEUE_HARD_LIMIT_FACTOR;
+	if (disconnectOnBackpressure || overHardLimit) {
+		g_logger.gameLog(spdlog::level::warn, fmt::format("{:s} disconnected for exceeding the send queue limit ({:d} messages, {:d} bytes).", convertIPToString(getIP()), queuedMessages, queuedBytes));
+		manager.backpressureDisconnects++;
+		close(FORCE_CLOSE);
+		return false;
+	}
+
+	setBackpressured(true);
+	return true;
+}
+
+void Connection::setBackpressured(bool value)
+{
+	if (backpressured.exchange(value) != value) {
+		if (value) {
+			ConnectionManager::getInstance().backpressuredConnections++;
+		} else {
+			ConnectionManager::getInstance().backpressuredConnections--;
+		}
+	}
+}
+
 void Connection::internalSend(const OutputMessage_ptr& msg)
 {
+	// the message leaves the queue accounting before encryption changes its length
+	queuedMessages--;
+	queuedBytes -= msg->getLength();
+
 	protocol->onSendMessage(msg);
 	try {
 		writeTimer.expires_from_now(std::chrono::seconds(CONNECTION_WRITE_TIMEOUT));
@@ -335,6 +407,11 @@ void Connection::onWriteOperation(const boost::system::error_code& error)
 		return;
 	}
 
+	// hysteresis, resume non-critical packets once the queue drained to half
+	if (backpressured && queuedMessages <= getMaxQueuedMessages() / 2 && queuedBytes <= getMaxQueuedBytes() / 2) {
+		setBackpressured(false);
+	}
+
 	if (!messageQueue.empty()) {
 		internalSend(messageQueue.front());
 	} else if (closed) {
@@ -342,6 +419,16 @@ void Connection::onWriteOperation(const boost::system::error_code& error)
 	}
 }
 
+size_t Connection::getMaxQueuedMessages()
+{
+	return static_cast<size_t>(std::max<int32_t>(1, g_config.getNumber(ConfigManager::MAX_CONNECTION_QUEUE_MESSAGES)));
+}
+
+size_t Connection::getMaxQueuedBytes()
+{
+	return static_cast<size_t>(std::max<int32_t>(NETWORKMESSAGE_MAXSIZE, g_config.getNumber(ConfigManager::MAX_CONNECTION_QUEUE_BYTES)));
+}
+
 void Connection::handleTimeout(ConnectionWeak_ptr connectionWeak, const boost::system::error_code& error)
 {
 	if (error == boost::asio::error::operation_aborted) {
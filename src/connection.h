@@ -9,6 +9,8 @@
 
 static constexpr int32_t CONNECTION_WRITE_TIMEOUT = 30;
 static constexpr int32_t CONNECTION_READ_TIMEOUT = 30;
+// multiple of the send queue limits at which a connection is closed under every backpressure policy
+static constexpr size_t CONNECTION_QUEUE_HARD_LIMIT_FACTOR = 4;
 
 class Protocol;
 using Protocol_ptr = std::shared_ptr<Protocol>;
@@ -31,10 +33,16 @@ class ConnectionManager
 			return instance;
 		}
 
-		Connection_ptr createConnection(boost::asio::io_service& io_service, ConstServicePort_ptr servicePort);
+		Connection_ptr createConnection(boost::asio::io_service& io_service, ConstServicePort_ptr servicePort, boost::asio::ip::tcp::socket socket);
 		void releaseConnection(const Connection_ptr& connection);
 		void closeAll();
 
+		// send queue depth sampled on every send, the last bucket counts every deeper queue
+		static constexpr size_t QUEUE_DEPTH_BUCKETS = 257;
+		std::array<std::atomic<uint32_t>, QUEUE_DEPTH_BUCKETS> queueDepthSamples = {};
+		std::atomic<uint32_t> backpressuredConnections{0};
+		std::atomic<uint32_t> backpressureDisconnects{0};
+
 	private:
 		ConnectionManager() = default;
 
@@ -52,11 +60,11 @@ class Connection : public std::enable_shared_from_this<Connection>
 		enum { FORCE_CLOSE = true };
 
 		Connection(boost::asio::io_service& io_service,
-		ConstServicePort_ptr service_port) :
+		ConstServicePort_ptr service_port, boost::asio::ip::tcp::socket socket) :
 			readTimer(io_service),
 			writeTimer(io_service),
 			service_port(std::move(service_port)),
-			socket(io_service),
+			socket(std::move(socket)),
 			timeConnected(time(nullptr)) {}
 		~Connection();
 
@@ -66,12 +74,18 @@ class Connection : public std::enable_shared_from_this<Connection>
 		// Used by protocols that require server to send first
 		void accept(Protocol_ptr protocol);
 		void accept();
+		// Used by protocols that finish handling the first message away from the network thread,
+		// the callback runs on the network thread before reading is resumed
+		void suspendRead();
+		void resumeRead(std::function<void(void)> callback);
 
 		void send(const OutputMessage_ptr& msg);
 
 		uint32_t getIP();
 		bool isOtcProxy() const { return otcProxy; };
 		bool isHaProxy() const { return haProxy; };
+		// the client does not keep up with its send queue, non-critical packets should be skipped
+		bool isBackpressured() const { return backpressured; };
 
 	private:
 		void parseHeader(const boost::system::error_code& error);
@@ -83,13 +97,12 @@ class Connection : public std::enable_shared_from_this<Connection>
 
 		void closeSocket();
 		void internalSend(const OutputMessage_ptr& msg);
+		bool checkBackpressure();
+		void setBackpressured(bool value);
+		static size_t getMaxQueuedMessages();
+		static size_t getMaxQueuedBytes();
 
-		boost::asio::ip::tcp::socket& getSocket() {
-			return socket;
-		}
-		friend class ServicePort;
-
-		NetworkMessage msg;
+		NetworkMessage_ptr msg = NetworkMessagePool::getMessage();
 
 		boost::asio::steady_timer readTimer;
 		boost::asio::steady_timer writeTimer;
@@ -97,6 +110,8 @@ class Connection : public std::enable_shared_from_this<Connection>
 		std::recursive_mutex connectionLock;
 
 		std::list<OutputMessage_ptr> messageQueue;
+		size_t queuedMessages = 0;
+		size_t queuedBytes = 0;
 
 		ConstServicePort_ptr service_port;
 		Protocol_ptr protocol;
@@ -109,7 +124,10 @@ class Connection : public std::enable_shared_from_this<Connection>
 		bool otcProxy = false;
 		bool haProxy = false;
 
+		std::atomic<bool> backpressured{false};
+		bool disconnectOnBackpressure = false;
 		bool closed = false;
+		bool readSuspended = false;
 		bool receivedFirst = false;
 		bool receivedFirstHeader = false;
 };
@@ -539,6 +539,7 @@ void Container::addThing(int32_t index, Thing* thing)
 	item->setParent(this);
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	invalidateTileCaches();
 
 	//send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -550,6 +551,7 @@ void Container::addItemBack(Item* item)
 {
 	addItem(item);
 	updateItemWeight(item->getWeight());
+	invalidateTileCaches();
 
 	//send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -595,6 +597,7 @@ void Container::replaceThing(uint32_t index, Thing* thing)
 	itemlist[index] = item;
 	item->setParent(this);
 	updateItemWeight(-static_cast<int32_t>(replacedItem->getWeight()) + item->getWeight());
+	invalidateTileCaches();
 
 	//send change to client
 	if (getParent()) {
@@ -636,6 +639,7 @@ void Container::removeThing(Thing* thing, uint32_t count)
 
 		item->setParent(nullptr);
 		itemlist.erase(itemlist.begin() + index);
+		invalidateTileCaches();
 	}
 }
 
@@ -745,6 +749,7 @@ void Container::internalAddThing(uint32_t, Thing* thing)
 	item->setParent(this);
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	invalidateTileCaches();
 }
 
 void Container::startDecaying()
@@ -508,6 +508,7 @@ class Creature : virtual public Thing
 		static constexpr int32_t maxWalkCacheHeight = (mapWalkHeight - 1) / 2;
 
 		Position position;
+		uint64_t spectatorMark = 0;
 
 		std::array<CountBlock_t, CREATURE_DAMAGEMAP_SIZE> damageMap;
 		uint8_t actDamageEntry = 0;
@@ -585,6 +586,7 @@ class Creature : virtual public Thing
 
 		friend class Game;
 		friend class Map;
+		friend class SpectatorVec;
 		friend class LuaScriptInterface;
 		friend class Monster;
 		friend class DynamicTile;
@@ -224,6 +224,8 @@ bool CreatureEvent::configureEvent(const pugi::xml_node& node)
 		type = CREATURE_EVENT_MANACHANGE;
 	} else if (tmpStr == "extendedopcode") {
 		type = CREATURE_EVENT_EXTENDED_OPCODE;
+	} else if (tmpStr == "binaryopcode") {
+		type = CREATURE_EVENT_BINARY_OPCODE;
 	} else {
 		std::cout << "[Error - CreatureEvent::configureEvent] Invalid type for creature event: " << eventName << std::endl;
 		return false;
@@ -273,6 +275,9 @@ std::string CreatureEvent::getScriptEventName() const
 		case CREATURE_EVENT_EXTENDED_OPCODE:
 			return "onExtendedOpcode";
 
+		case CREATURE_EVENT_BINARY_OPCODE:
+			return "onBinaryOpcode";
+
 		case CREATURE_EVENT_NONE:
 		default:
 			return std::string();
@@ -606,3 +611,40 @@ void CreatureEvent::executeExtendedOpcode(Player* player, uint8_t opcode, const
 
 	scriptInterface->callVoidFunction(3);
 }
+
+void CreatureEvent::executeBinaryOpcode(Player* player, uint8_t opcode, NetworkMessageView& message)
+{
+	//onBinaryOpcode(player, opcode, message, size)
+	if (!scriptInterface->reserveScriptEnv()) {
+		std::cout << "[Error - CreatureEvent::executeBinaryOpcode] Call stack overflow" << std::endl;
+		return;
+	}
+
+	ScriptEnvironment* env = scriptInterface->getScriptEnv();
+	env->setScriptId(scriptId, scriptInterface);
+
+	lua_State* L = scriptInterface->getLuaState();
+
+	scriptInterface->pushFunction(scriptId);
+
+	LuaScriptInterface::pushUserdata<Player>(L, player);
+	LuaScriptInterface::setMetatable(L, -1, "Player");
+
+	lua_pushnumber(L, opcode);
+
+	// the view reads the received packet itself, the script only borrows it for this call
+	LuaScriptInterface::pushUserdata<NetworkMessageView>(L, &message);
+	LuaScriptInterface::setMetatable(L, -1, "NetworkMessageView");
+	lua_pushvalue(L, -1);
+	int32_t messageRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	lua_pushnumber(L, message.getSize());
+
+	scriptInterface->callVoidFunction(4);
+
+	// detach the view so a message kept by the script is empty instead of dangling
+	lua_rawgeti(L, LUA_REGISTRYINDEX, messageRef);
+	*LuaScriptInterface::getRawUserdata<NetworkMessageView>(L, -1) = nullptr;
+	lua_pop(L, 1);
+	luaL_unref(L, LUA_REGISTRYINDEX, messageRef);
+}
@@ -25,6 +25,7 @@
 #include "enums.h"
 
 class CreatureEvent;
+class NetworkMessageView;
 using CreatureEvent_ptr = std::unique_ptr<CreatureEvent>;
 
 enum CreatureEventType_t {
@@ -41,6 +42,7 @@ enum CreatureEventType_t {
 	CREATURE_EVENT_HEALTHCHANGE,
 	CREATURE_EVENT_MANACHANGE,
 	CREATURE_EVENT_EXTENDED_OPCODE, // otclient additional network opcodes
+	CREATURE_EVENT_BINARY_OPCODE, // same opcodes, payload read in place from the packet
 };
 
 class CreatureEvent final : public Event
@@ -85,6 +87,7 @@ class CreatureEvent final : public Event
 		void executeHealthChange(Creature* creature, Creature* attacker, CombatDamage& damage);
 		void executeManaChange(Creature* creature, Creature* attacker, CombatDamage& damage);
 		void executeExtendedOpcode(Player* player, uint8_t opcode, const std::string& buffer);
+		void executeBinaryOpcode(Player* player, uint8_t opcode, NetworkMessageView& message);
 		//
 
 	private:
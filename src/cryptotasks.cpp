@@ -0,0 +1,82 @@
+/**
+ * The Violet Project - a free and open-source MMORPG server emulator
+ * Copyright (C) 2021 - Ezzz <alejandromujica.rsm@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "otpch.h"
+
+#include "cryptotasks.h"
+
+void CryptoTasks::start(size_t threadCount)
+{
+	threadState.store(THREAD_STATE_RUNNING, std::memory_order_relaxed);
+	threads.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i) {
+		threads.emplace_back(&CryptoTasks::threadMain, this);
+	}
+}
+
+void CryptoTasks::threadMain()
+{
+	std::unique_lock<std::mutex> taskLockUnique(taskLock, std::defer_lock);
+	while (threadState.load(std::memory_order_relaxed) != THREAD_STATE_TERMINATED) {
+		taskLockUnique.lock();
+		if (tasks.empty()) {
+			taskSignal.wait(taskLockUnique);
+		}
+
+		if (!tasks.empty()) {
+			auto task = std::move(tasks.front());
+			tasks.pop_front();
+			taskLockUnique.unlock();
+			task();
+		} else {
+			taskLockUnique.unlock();
+		}
+	}
+}
+
+void CryptoTasks::addTask(std::function<void(void)> task)
+{
+	taskLock.lock();
+	if (threadState.load(std::memory_order_relaxed) == THREAD_STATE_RUNNING) {
+		tasks.push_back(std::move(task));
+	}
+	taskLock.unlock();
+
+	taskSignal.notify_one();
+}
+
+void CryptoTasks::shutdown()
+{
+	taskLock.lock();
+	threadState.store(THREAD_STATE_TERMINATED, std::memory_order_relaxed);
+	// pending logins are dropped, their connections are closed with the server
+	tasks.clear();
+	taskLock.unlock();
+	taskSignal.notify_all();
+}
+
+void CryptoTasks::join()
+{
+	for (std::thread& thread : threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+	threads.clear();
+}
@@ -0,0 +1,53 @@
+/**
+ * The Violet Project - a free and open-source MMORPG server emulator
+ * Copyright (C) 2021 - Ezzz <alejandromujica.rsm@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef FS_CRYPTOTASKS_H_6A1F0C2E8B3D4F5A9E7C1B2D3F4A5B6C
+#define FS_CRYPTOTASKS_H_6A1F0C2E8B3D4F5A9E7C1B2D3F4A5B6C
+
+#include <condition_variable>
+#include "enums.h"
+
+// Worker pool running the RSA decryption of login packets away from the network thread
+class CryptoTasks
+{
+	public:
+		CryptoTasks() = default;
+		void start(size_t threadCount);
+		void shutdown();
+		void join();
+
+		bool isRunning() const {
+			return threadState.load(std::memory_order_relaxed) == THREAD_STATE_RUNNING;
+		}
+
+		void addTask(std::function<void(void)> task);
+
+	private:
+		void threadMain();
+
+		std::vector<std::thread> threads;
+		std::list<std::function<void(void)>> tasks;
+		std::mutex taskLock;
+		std::condition_variable taskSignal;
+		std::atomic<ThreadState> threadState{THREAD_STATE_TERMINATED};
+};
+
+extern CryptoTasks g_cryptoTasks;
+
+#endif
@@ -104,19 +104,24 @@ const Node& Loader::parseTree()
 }
 
 bool Loader::getProps(const Node& node, PropStream& props)
+{
+	return getProps(node, props, propBuffer);
+}
+
+bool Loader::getProps(const Node& node, PropStream& props, std::vector<char>& buffer)
 {
 	auto size = std::distance(node.propsBegin, node.propsEnd);
 	if (size == 0) {
 		return false;
 	}
-	propBuffer.resize(size);
+	buffer.resize(size);
 	bool lastEscaped = false;
 
-	auto escapedPropEnd = std::copy_if(node.propsBegin, node.propsEnd, propBuffer.begin(), [&lastEscaped](const char& byte) {
+	auto escapedPropEnd = std::copy_if(node.propsBegin, node.propsEnd, buffer.begin(), [&lastEscaped](const char& byte) {
 		lastEscaped = byte == static_cast<char>(Node::ESCAPE) && !lastEscaped;
 		return !lastEscaped;
 	});
-	props.init(&propBuffer[0], std::distance(propBuffer.begin(), escapedPropEnd));
+	props.init(&buffer[0], std::distance(buffer.begin(), escapedPropEnd));
 	return true;
 }
 
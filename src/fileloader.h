@@ -64,6 +64,8 @@ class Loader {
 public:
 	Loader(const std::string& fileName, const Identifier& acceptedIdentifier);
 	bool getProps(const Node& node, PropStream& props);
+	// reentrant variant, the unescaped bytes live in the caller's buffer
+	static bool getProps(const Node& node, PropStream& props, std::vector<char>& buffer);
 	const Node& parseTree();
 };
 
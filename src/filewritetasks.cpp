@@ -0,0 +1,153 @@
+/**
+ * The Violet Project - a free and open-source MMORPG server emulator
+ * Copyright (C) 2021 - Ezzz <alejandromujica.rsm@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "otpch.h"
+
+#include "filewritetasks.h"
+#include "tasks.h"
+
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+extern Dispatcher g_dispatcher;
+
+void FileWriteTasks::threadMain()
+{
+	std::unique_lock<std::mutex> taskLockUnique(taskLock, std::defer_lock);
+	while (getState() != THREAD_STATE_TERMINATED) {
+		taskLockUnique.lock();
+		if (tasks.empty() && getState() != THREAD_STATE_TERMINATED) {
+			taskSignal.wait(taskLockUnique);
+		}
+		taskLockUnique.unlock();
+
+		runNextTask();
+	}
+}
+
+void FileWriteTasks::addTask(std::string path, std::string data, std::function<void(bool)> callback/* = nullptr*/)
+{
+	bool signal = false;
+	taskLock.lock();
+	if (getState() != THREAD_STATE_TERMINATED) {
+		signal = tasks.empty();
+		tasks.emplace_back(std::move(path), std::move(data), std::move(callback));
+		taskLock.unlock();
+	} else {
+		taskLock.unlock();
+
+		// the writer is not running, saves must not be dropped; older queued writes go first
+		flush();
+
+		std::lock_guard<std::mutex> writeGuard(writeLock);
+		bool success = writeFile(path, data);
+		if (callback) {
+			callback(success);
+		}
+		return;
+	}
+
+	if (signal) {
+		taskSignal.notify_one();
+	}
+}
+
+bool FileWriteTasks::runNextTask()
+{
+	// taking and writing a task under one lock keeps the writes in queue order whichever
+	// thread runs them, so two saves of a file never share its temporary file
+	std::lock_guard<std::mutex> writeGuard(writeLock);
+
+	std::unique_lock<std::mutex> guard{ taskLock };
+	if (tasks.empty()) {
+		return false;
+	}
+
+	FileWriteTask task = std::move(tasks.front());
+	tasks.pop_front();
+	guard.unlock();
+
+	runTask(task);
+	return true;
+}
+
+void FileWriteTasks::runTask(const FileWriteTask& task)
+{
+#ifdef STATS_ENABLED
+	AutoStat stat("FileWriteTasks::runTask");
+#endif
+
+	bool success = writeFile(task.path, task.data);
+	if (task.callback) {
+		g_dispatcher.addTask(createTask(std::bind(task.callback, success)));
+	}
+}
+
+bool FileWriteTasks::writeFile(const std::string& path, const std::string& data)
+{
+	const std::string tmpPath = path + ".tmp";
+
+	FILE* file = fopen(tmpPath.c_str(), "wb");
+	if (!file) {
+		std::cout << "[Error - FileWriteTasks::writeFile] Cannot open " << tmpPath << " for writing." << std::endl;
+		return false;
+	}
+
+	bool success = fwrite(data.data(), 1, data.size(), file) == data.size() && fflush(file) == 0;
+#ifdef _WIN32
+	success = success && _commit(_fileno(file)) == 0;
+#else
+	success = success && fsync(fileno(file)) == 0;
+#endif
+	success = fclose(file) == 0 && success;
+
+	if (!success) {
+		std::cout << "[Error - FileWriteTasks::writeFile] Failed to write " << tmpPath << '.' << std::endl;
+		std::error_code ec;
+		std::filesystem::remove(tmpPath, ec);
+		return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec) {
+		std::cout << "[Error - FileWriteTasks::writeFile] Cannot replace " << path << ": " << ec.message() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void FileWriteTasks::flush()
+{
+	while (runNextTask()) {}
+}
+
+void FileWriteTasks::shutdown()
+{
+	taskLock.lock();
+	setState(THREAD_STATE_TERMINATED);
+	taskLock.unlock();
+	flush();
+	taskSignal.notify_one();
+}
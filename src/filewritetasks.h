@@ -0,0 +1,64 @@
+/**
+ * The Violet Project - a free and open-source MMORPG server emulator
+ * Copyright (C) 2021 - Ezzz <alejandromujica.rsm@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef FS_FILEWRITETASKS_H_3D7B1E9A4C6F4E2B8A5D0C1F7E9B2A64
+#define FS_FILEWRITETASKS_H_3D7B1E9A4C6F4E2B8A5D0C1F7E9B2A64
+
+#include <condition_variable>
+#include "thread_holder_base.h"
+#include "enums.h"
+
+struct FileWriteTask {
+	FileWriteTask(std::string&& path, std::string&& data, std::function<void(bool)>&& callback) :
+		path(std::move(path)), data(std::move(data)), callback(std::move(callback)) {}
+
+	std::string path;
+	std::string data;
+	std::function<void(bool)> callback;
+};
+
+// Background writer for save files: every file is written to a temporary
+// sibling, synced to disk and then renamed over the previous version, so a
+// crash mid-save never leaves a truncated file behind
+class FileWriteTasks : public ThreadHolder<FileWriteTasks>
+{
+	public:
+		FileWriteTasks() = default;
+		void flush();
+		void shutdown();
+
+		void addTask(std::string path, std::string data, std::function<void(bool)> callback = nullptr);
+
+		void threadMain();
+
+		static bool writeFile(const std::string& path, const std::string& data);
+	private:
+		bool runNextTask();
+		void runTask(const FileWriteTask& task);
+
+		std::list<FileWriteTask> tasks;
+		std::mutex taskLock;
+		// held from taking a task until its file is renamed
+		std::mutex writeLock;
+		std::condition_variable taskSignal;
+};
+
+extern FileWriteTasks g_fileWriteTasks;
+
+#endif
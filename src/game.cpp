@@ -26,7 +26,9 @@
 #include "configmanager.h"
 #include "creature.h"
 #include "creatureevent.h"
+#include "cryptotasks.h"
 #include "databasetasks.h"
+#include "filewritetasks.h"
 #include "events.h"
 #include "game.h"
 #include "globalevent.h"
@@ -179,6 +181,7 @@ void Game::setGameState(GameState_t newState)
 
 			g_scheduler.stop();
 			g_databaseTasks.stop();
+			g_fileWriteTasks.stop();
 			g_dispatcher.stop();
 #ifdef STATS_ENABLED
 			g_stats.stop();
@@ -4641,7 +4644,7 @@ void Game::proceduralRefreshMap()
 		bool increaseRefreshSet = true;
 		int32_t tilesPerCycle = g_config.getNumber(ConfigManager::MAP_REFRESH_TILES_PER_CYCLE);
 		for (int32_t i = nextMapRefreshSet; i <= nextMapRefreshSet + tilesPerCycle; i++) {
-			if (i == tilesToRefresh.size() - 1) {
+			if (i >= static_cast<int32_t>(tilesToRefresh.size()) - 1) {
 				nextMapRefreshSet = 0;
 				increaseRefreshSet = false;
 				break;
@@ -4764,6 +4767,8 @@ void Game::shutdown()
 
 	g_scheduler.shutdown();
 	g_databaseTasks.shutdown();
+	g_cryptoTasks.shutdown();
+	g_fileWriteTasks.shutdown();
 	g_dispatcher.shutdown();
 #ifdef STATS_ENABLED
 	g_stats.shutdown();
@@ -5340,14 +5345,30 @@ void Game::playerDebugAssert(uint32_t playerId, const std::string& assertLine, c
 	}
 }
 
-void Game::parsePlayerExtendedOpcode(uint32_t playerId, uint8_t opcode, const std::string& buffer)
+void Game::parsePlayerExtendedOpcode(uint32_t playerId, uint8_t opcode, const NetworkMessage& msg, uint16_t size)
 {
 	Player* player = getPlayerByID(playerId);
 	if (!player) {
 		return;
 	}
 
-	for (CreatureEvent* creatureEvent : player->getCreatureEvents(CREATURE_EVENT_EXTENDED_OPCODE)) {
+	// the protocol checked the payload fits the message and skips it once the handlers ran
+	NetworkMessage::MsgSize_t payloadPosition = msg.getBufferPosition();
+	for (CreatureEvent* creatureEvent : player->getCreatureEvents(CREATURE_EVENT_BINARY_OPCODE)) {
+#ifdef STATS_ENABLED
+		AutoStat stat("onBinaryOpcode");
+#endif
+		NetworkMessageView message(msg.getBuffer() + payloadPosition, size);
+		creatureEvent->executeBinaryOpcode(player, opcode, message);
+	}
+
+	const CreatureEventList& extendedOpcodeEvents = player->getCreatureEvents(CREATURE_EVENT_EXTENDED_OPCODE);
+	if (extendedOpcodeEvents.empty()) {
+		return;
+	}
+
+	const std::string buffer(reinterpret_cast<const char*>(msg.getBuffer()) + payloadPosition, size);
+	for (CreatureEvent* creatureEvent : extendedOpcodeEvents) {
 		creatureEvent->executeExtendedOpcode(player, opcode, buffer);
 	}
 }
@@ -5966,20 +5987,29 @@ bool Game::playerBuyPremiumBattlepass(uint32_t playerId)
 	return true;
 }
 
-void Game::clearTileFromRefresh(const Tile* tile)
+void Game::addTileToList(std::vector<Tile*>& list, Tile* tile, uint32_t Tile::* index)
 {
-	auto it = std::find(tilesToRefresh.begin(), tilesToRefresh.end(), tile);
-	if (it != tilesToRefresh.end()) {
-		tilesToRefresh.erase(it);
+	if (tile->*index != Tile::UNLISTED) {
+		return;
 	}
+
+	tile->*index = static_cast<uint32_t>(list.size());
+	list.push_back(tile);
 }
 
-void Game::clearTileFromSave(const Tile* tile)
+void Game::removeTileFromList(std::vector<Tile*>& list, Tile* tile, uint32_t Tile::* index)
 {
-	auto it = std::find(tilesToSave.begin(), tilesToSave.end(), tile);
-	if (it != tilesToSave.end()) {
-		tilesToSave.erase(it);
+	uint32_t position = tile->*index;
+	if (position == Tile::UNLISTED) {
+		return;
 	}
+
+	Tile* last = list.back();
+	list[position] = last;
+	last->*index = position;
+	list.pop_back();
+
+	tile->*index = Tile::UNLISTED;
 }
 
 Item* Game::getRealUniqueItem(uint32_t uniqueId)
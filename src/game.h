@@ -434,7 +434,7 @@ class Game
 		void closeRuleViolationReport(Player* player);
 		void cancelRuleViolationReport(Player* player);
 
-		void parsePlayerExtendedOpcode(uint32_t playerId, uint8_t opcode, const std::string& buffer);
+		void parsePlayerExtendedOpcode(uint32_t playerId, uint8_t opcode, const NetworkMessage& msg, uint16_t size);
 
 		bool jumpPossible(int32_t x, int32_t y, int32_t z, bool avoidPlayers);
 		bool searchFreeField(Creature* creature, uint16_t& x, uint16_t& y, uint8_t& z, int32_t distance, bool jump, bool allowHouses);
@@ -562,27 +562,31 @@ class Game
 		std::forward_list<Item*> toDecayItems;
 
 		bool isTileInRefreshList(const Tile* tile) const {
-		    return std::find(tilesToRefresh.begin(), tilesToRefresh.end(), tile) != tilesToRefresh.end();
+			return tile->refreshListIndex != Tile::UNLISTED;
 		}
 
-		void clearTileFromRefresh(const Tile* tile);
-		std::vector<Tile*> getTilesToRefresh() const {
+		void clearTileFromRefresh(Tile* tile) {
+			removeTileFromList(tilesToRefresh, tile, &Tile::refreshListIndex);
+		}
+		const std::vector<Tile*>& getTilesToRefresh() const {
 			return tilesToRefresh;
 		}
 		void addTileToRefresh(Tile* tile) {
-			tilesToRefresh.push_back(tile);
+			addTileToList(tilesToRefresh, tile, &Tile::refreshListIndex);
 		}
 
-	    bool isTileInSaveList(const Tile* tile) const {
-		    return std::find(tilesToSave.begin(), tilesToSave.end(), tile) != tilesToSave.end();
-	    }
+		bool isTileInSaveList(const Tile* tile) const {
+			return tile->saveListIndex != Tile::UNLISTED;
+		}
 
-		void clearTileFromSave(const Tile* tile);
-		std::vector<Tile*> getTilesToSave() const {
+		void clearTileFromSave(Tile* tile) {
+			removeTileFromList(tilesToSave, tile, &Tile::saveListIndex);
+		}
+		const std::vector<Tile*>& getTilesToSave() const {
 			return tilesToSave;
 		}
 		void addTileToSave(Tile* tile) {
-			tilesToSave.push_back(tile);
+			addTileToList(tilesToSave, tile, &Tile::saveListIndex);
 		}
 
 		bool isMapSavingEnabled() const {
@@ -655,9 +659,14 @@ class Game
 
 		std::map<uint32_t, BedItem*> bedSleepersMap;
 
+		// tiles remember their own index in these lists, so membership and removal are O(1);
+		// removal moves the last tile into the freed slot, the lists are unordered
 		std::vector<Tile*> tilesToRefresh;
 		std::vector<Tile*> tilesToSave;
 
+		static void addTileToList(std::vector<Tile*>& list, Tile* tile, uint32_t Tile::* index);
+		static void removeTileFromList(std::vector<Tile*>& list, Tile* tile, uint32_t Tile::* index);
+
 		static constexpr uint8_t LIGHT_DAY = 250;
 		static constexpr uint8_t LIGHT_NIGHT = 40;
 		// 1h realtime   = 1day worldtime
@@ -156,6 +156,7 @@ class House
 
 		void setName(std::string houseName) {
 			this->houseName = houseName;
+			dirty = true;
 		}
 		const std::string& getName() const {
 			return houseName;
@@ -244,6 +245,14 @@ class House
 			return static_cast<uint32_t>(std::ceil(bedsList.size() / 2.)); //each bed takes 2 sqms of space, ceil is just for bad maps
 		}
 
+		// set whenever the house name or anything on its tiles changes, cleared once the house file is written
+		bool isDirty() const {
+			return dirty;
+		}
+		void setDirty(bool dirty) {
+			this->dirty = dirty;
+		}
+
 		bool transferToDepot() const;
 	private:
 		bool transferToDepot(Player* player) const;
@@ -276,6 +285,7 @@ class House
 
 		bool isLoaded = false;
 		bool guildHall = false;
+		bool dirty = true;
 };
 
 using HouseMap = std::map<uint32_t, House*>;
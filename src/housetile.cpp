@@ -56,6 +56,12 @@ void HouseTile::internalAddThing(uint32_t index, Thing* thing)
 	}
 }
 
+void HouseTile::invalidateSaveRecord()
+{
+	Tile::invalidateSaveRecord();
+	house->setDirty(true);
+}
+
 void HouseTile::updateHouse(Item* item)
 {
 	if (item->getParent() != this) {
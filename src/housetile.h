@@ -41,6 +41,8 @@ class HouseTile final : public DynamicTile
 		void addThing(int32_t index, Thing* thing) override;
 		void internalAddThing(uint32_t index, Thing* thing) override;
 
+		void invalidateSaveRecord() override;
+
 		const House* getHouse() const {
 			return house;
 		}
@@ -74,9 +74,14 @@ bool IOMap::loadMap(Map* map, const std::string& fileName, bool replaceExistingT
 	std::cout << "> Loading " << fileName << std::endl;
 
 	int64_t start = OTSYS_TIME();
+	int64_t treeTime = 0;
+	int64_t decodeTime = 0;
+	int64_t buildTime = 0;
+	const size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
 	try {
 		OTB::Loader loader{fileName, OTB::Identifier{{'O', 'T', 'B', 'M'}}};
 		auto& root = loader.parseTree();
+		treeTime = OTSYS_TIME() - start;
 
 		PropStream propStream;
 		if (!loader.getProps(root, propStream)) {
@@ -115,12 +120,52 @@ bool IOMap::loadMap(Map* map, const std::string& fileName, bool replaceExistingT
 			return false;
 		}
 
+		// tile areas are decoded in batches on worker threads, tiles are
+		// still created and inserted here in file order
+		const size_t batchSize = threads * 256;
+		std::vector<const OTB::Node*> tileAreaNodes;
+		std::vector<DecodedTileArea> tileAreas;
+		tileAreaNodes.reserve(batchSize);
+
+		auto flushTileAreas = [&]() {
+			int64_t decodeStart = OTSYS_TIME();
+			decodeTileAreas(tileAreaNodes, tileAreas, threads);
+			int64_t buildStart = OTSYS_TIME();
+			decodeTime += buildStart - decodeStart;
+
+			bool success = true;
+			for (const DecodedTileArea& area : tileAreas) {
+				if (!area.error.empty()) {
+					setLastErrorString(area.error);
+					success = false;
+					break;
+				}
+
+				if (!parseTileArea(loader, area, *map, replaceExistingTiles)) {
+					success = false;
+					break;
+				}
+			}
+
+			buildTime += OTSYS_TIME() - buildStart;
+			tileAreaNodes.clear();
+			return success;
+		};
+
 		for (auto& mapDataNode : mapNode.children) {
 			if (mapDataNode.type == OTBM_TILE_AREA) {
-				if (!parseTileArea(loader, mapDataNode, *map, replaceExistingTiles)) {
+				tileAreaNodes.push_back(&mapDataNode);
+				if (tileAreaNodes.size() >= batchSize && !flushTileAreas()) {
 					return false;
 				}
-			} else if (mapDataNode.type == OTBM_TOWNS) {
+				continue;
+			}
+
+			if (!tileAreaNodes.empty() && !flushTileAreas()) {
+				return false;
+			}
+
+			if (mapDataNode.type == OTBM_TOWNS) {
 				if (!parseTowns(loader, mapDataNode, *map)) {
 					return false;
 				}
@@ -133,15 +178,119 @@ bool IOMap::loadMap(Map* map, const std::string& fileName, bool replaceExistingT
 				return false;
 			}
 		}
+
+		if (!tileAreaNodes.empty() && !flushTileAreas()) {
+			return false;
+		}
 	} catch (const OTB::InvalidOTBFormat& err) {
 		setLastErrorString(err.what());
 		return false;
 	}
 
-	std::cout << "> Map loading time: " << (OTSYS_TIME() - start) / (1000.) << " seconds." << std::endl;
+	std::cout << "> Map loading time: " << (OTSYS_TIME() - start) / (1000.) << " seconds (node tree: " << treeTime / (1000.)
+	          << ", tile decoding on " << threads << " threads: " << decodeTime / (1000.) << ", tile creation: " << buildTime / (1000.) << ")." << std::endl;
+	return true;
+}
+
+bool IOMap::decodeTileArea(const OTB::Node& tileAreaNode, DecodedTileArea& area)
+{
+	std::vector<char> scratch;
+	PropStream propStream;
+	if (!OTB::Loader::getProps(tileAreaNode, propStream, scratch)) {
+		area.error = "Invalid map node.";
+		return false;
+	}
+
+	OTBM_Destination_coords area_coord;
+	if (!propStream.read(area_coord)) {
+		area.error = "Invalid map node.";
+		return false;
+	}
+
+	area.z = area_coord.z;
+	area.tiles.reserve(tileAreaNode.children.size());
+
+	for (const auto& tileNode : tileAreaNode.children) {
+		if (tileNode.type != OTBM_TILE && tileNode.type != OTBM_HOUSETILE) {
+			area.error = "Unknown tile node.";
+			return false;
+		}
+
+		PropStream tilePropStream;
+		if (!OTB::Loader::getProps(tileNode, tilePropStream, scratch)) {
+			area.error = "Could not read node data.";
+			return false;
+		}
+
+		const size_t propsSize = tilePropStream.size();
+
+		OTBM_Tile_coords tile_coord;
+		if (!tilePropStream.read(tile_coord)) {
+			area.error = "Could not read tile position.";
+			return false;
+		}
+
+		DecodedTile tile;
+		tile.node = &tileNode;
+		tile.x = area_coord.x + tile_coord.x;
+		tile.y = area_coord.y + tile_coord.y;
+		tile.houseId = 0;
+
+		if (tileNode.type == OTBM_HOUSETILE && !tilePropStream.read<uint32_t>(tile.houseId)) {
+			area.error = fmt::format("[x:{}, y:{}, z:{}] Could not read house id.", tile.x, tile.y, area.z);
+			return false;
+		}
+
+		// keep only the attributes following the tile header
+		const size_t headerSize = propsSize - tilePropStream.size();
+		tile.propsOffset = area.buffer.size();
+		tile.propsSize = tilePropStream.size();
+		area.buffer.insert(area.buffer.end(), scratch.begin() + headerSize, scratch.begin() + propsSize);
+
+		tile.itemsBegin = area.items.size();
+		for (const auto& itemNode : tileNode.children) {
+			DecodedItem item {&itemNode, area.buffer.size(), 0, false};
+
+			PropStream itemPropStream;
+			if (itemNode.type == OTBM_ITEM && OTB::Loader::getProps(itemNode, itemPropStream, scratch)) {
+				item.propsSize = itemPropStream.size();
+				item.hasProps = true;
+				area.buffer.insert(area.buffer.end(), scratch.begin(), scratch.begin() + item.propsSize);
+			}
+
+			area.items.push_back(item);
+		}
+		tile.itemsEnd = area.items.size();
+
+		area.tiles.push_back(tile);
+	}
 	return true;
 }
 
+void IOMap::decodeTileAreas(std::vector<const OTB::Node*>& nodes, std::vector<DecodedTileArea>& areas, size_t threads)
+{
+	areas.clear();
+	areas.resize(nodes.size());
+
+	std::atomic<size_t> next(0);
+	auto worker = [&]() {
+		for (size_t i = next++; i < nodes.size(); i = next++) {
+			decodeTileArea(*nodes[i], areas[i]);
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (size_t i = 1, count = std::min(threads, nodes.size()); i < count; ++i) {
+		workers.emplace_back(worker);
+	}
+
+	worker();
+
+	for (std::thread& thread : workers) {
+		thread.join();
+	}
+}
+
 bool IOMap::parseMapDataAttributes(OTB::Loader& loader, const OTB::Node& mapNode, Map& map, const std::string& fileName)
 {
 	PropStream propStream;
@@ -191,44 +340,16 @@ bool IOMap::parseMapDataAttributes(OTB::Loader& loader, const OTB::Node& mapNode
 	return true;
 }
 
-bool IOMap::parseTileArea(OTB::Loader& loader, const OTB::Node& tileAreaNode, Map& map, bool replaceExistingTiles)
+bool IOMap::parseTileArea(OTB::Loader& loader, const DecodedTileArea& area, Map& map, bool replaceExistingTiles)
 {
-	PropStream propStream;
-	if (!loader.getProps(tileAreaNode, propStream)) {
-		setLastErrorString("Invalid map node.");
-		return false;
-	}
-
-	OTBM_Destination_coords area_coord;
-	if (!propStream.read(area_coord)) {
-		setLastErrorString("Invalid map node.");
-		return false;
-	}
-
-	const uint16_t base_x = area_coord.x;
-	const uint16_t base_y = area_coord.y;
-	const uint16_t z = area_coord.z;
+	const uint16_t z = area.z;
 
-	for (const auto& tileNode : tileAreaNode.children) {
-		if (tileNode.type != OTBM_TILE && tileNode.type != OTBM_HOUSETILE) {
-			setLastErrorString("Unknown tile node.");
-			return false;
-		}
+	for (const DecodedTile& decodedTile : area.tiles) {
+		const uint16_t x = decodedTile.x;
+		const uint16_t y = decodedTile.y;
 
 		PropStream tilePropStream;
-		if (!loader.getProps(tileNode, tilePropStream)) {
-			setLastErrorString("Could not read node data.");
-			return false;
-		}
-
-		OTBM_Tile_coords tile_coord;
-		if (!tilePropStream.read(tile_coord)) {
-			setLastErrorString("Could not read tile position.");
-			return false;
-		}
-
-		const uint16_t x = base_x + tile_coord.x;
-		const uint16_t y = base_y + tile_coord.y;
+		tilePropStream.init(area.buffer.data() + decodedTile.propsOffset, decodedTile.propsSize);
 
 		bool allowDecay = (map.getTile(x, y, z) == nullptr) || replaceExistingTiles;
 		bool isHouseTile = false;
@@ -237,13 +358,8 @@ bool IOMap::parseTileArea(OTB::Loader& loader, const OTB::Node& tileAreaNode, Ma
 		Item* ground_item = nullptr;
 		uint32_t tileflags = TILESTATE_NONE;
 
-		if (tileNode.type == OTBM_HOUSETILE) {
-			uint32_t houseId;
-			if (!tilePropStream.read<uint32_t>(houseId)) {
-				setLastErrorString(fmt::format("[x:{}, y:{}, z:{}] Could not read house id.", x, y, z));
-				return false;
-			}
-
+		if (decodedTile.node->type == OTBM_HOUSETILE) {
+			uint32_t houseId = decodedTile.houseId;
 			house = map.houses.addHouse(houseId);
 			if (!house) {
 				setLastErrorString(fmt::format("[x:{}, y:{}, z:{}] Could not create house id: {}", x, y, z, houseId));
@@ -310,18 +426,22 @@ bool IOMap::parseTileArea(OTB::Loader& loader, const OTB::Node& tileAreaNode, Ma
 			}
 		}
 
-		for (const auto& itemNode : tileNode.children) {
+		for (size_t i = decodedTile.itemsBegin; i < decodedTile.itemsEnd; ++i) {
+			const DecodedItem& decodedItem = area.items[i];
+			const OTB::Node& itemNode = *decodedItem.node;
 			if (itemNode.type != OTBM_ITEM) {
 				std::cerr << "[Warning] Unknown node type in tile at [x:" << x << ", y:" << y << ", z:" << z << "]. Skipping.\n";
 				continue;
 			}
 
-			PropStream stream;
-			if (!loader.getProps(itemNode, stream)) {
+			if (!decodedItem.hasProps) {
 				std::cerr << "[Warning] Invalid item node at [x:" << x << ", y:" << y << ", z:" << z << "]. Skipping.\n";
 				continue;
 			}
 
+			PropStream stream;
+			stream.init(area.buffer.data() + decodedItem.propsOffset, decodedItem.propsSize);
+
 			Item* item = Item::CreateItem(stream);
 			if (!item) {
 				std::cerr << "[Warning] Failed to create item in node at [x:" << x << ", y:" << y << ", z:" << z << "]. Skipping.\n";
@@ -155,10 +155,41 @@ class IOMap
 		}
 
 	private:
+		struct DecodedItem {
+			const OTB::Node* node;
+			size_t propsOffset;
+			size_t propsSize;
+			bool hasProps;
+		};
+
+		struct DecodedTile {
+			const OTB::Node* node;
+			uint16_t x;
+			uint16_t y;
+			uint32_t houseId;
+			size_t propsOffset;
+			size_t propsSize;
+			size_t itemsBegin;
+			size_t itemsEnd;
+		};
+
+		// a tile area with the unescaped properties of its tiles and items,
+		// produced on a worker thread and turned into tiles in file order
+		struct DecodedTileArea {
+			uint8_t z = 0;
+			std::vector<char> buffer;
+			std::vector<DecodedTile> tiles;
+			std::vector<DecodedItem> items;
+			std::string error;
+		};
+
+		static bool decodeTileArea(const OTB::Node& tileAreaNode, DecodedTileArea& area);
+		static void decodeTileAreas(std::vector<const OTB::Node*>& nodes, std::vector<DecodedTileArea>& areas, size_t threads);
+
 		bool parseMapDataAttributes(OTB::Loader& loader, const OTB::Node& mapNode, Map& map, const std::string& fileName);
 		bool parseWaypoints(OTB::Loader& loader, const OTB::Node& waypointsNode, Map& map);
 		bool parseTowns(OTB::Loader& loader, const OTB::Node& townsNode, Map& map);
-		bool parseTileArea(OTB::Loader& loader, const OTB::Node& tileAreaNode, Map& map, bool replaceExistingTiles = false);
+		bool parseTileArea(OTB::Loader& loader, const DecodedTileArea& area, Map& map, bool replaceExistingTiles = false);
 		std::string errorString;
 };
 
@@ -24,6 +24,7 @@
 #include "bed.h"
 #include "configmanager.h"
 #include "iomap.h"
+#include "filewritetasks.h"
 
 #include <fmt/format.h>
 #include <fstream>
@@ -32,6 +33,20 @@
 extern Game g_game;
 extern ConfigManager g_config;
 
+namespace {
+
+// tile type, x, y, z and, for house tiles, the house id precede the flags in every tile record
+constexpr size_t TILE_RECORD_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint8_t);
+constexpr size_t HOUSE_TILE_RECORD_HEADER_SIZE = TILE_RECORD_HEADER_SIZE + sizeof(uint32_t);
+
+template <typename T>
+void appendValue(std::string& buffer, T value)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}
+
 MapDataLoadResult_t IOMapSerialize::loadMapData()
 {
 	if (!g_config.getBoolean(ConfigManager::ENABLE_MAP_DATA_FILES)) {
@@ -94,7 +109,8 @@ MapDataLoadResult_t IOMapSerialize::loadMapData()
 
 			uint32_t tileFlags = 0;
 			propStream.read<uint32_t>(tileFlags);
-			tile->setFlags(tileFlags);
+			// the projectile flag is derived from the items added below, older files may carry a stale one
+			tile->setFlags(tileFlags & ~TILESTATE_BLOCKPROJECTILE);
 
 			uint32_t totalItems = 0;
 			propStream.read<uint32_t>(totalItems);
@@ -211,6 +227,7 @@ bool IOMapSerialize::loadHouseItems(Map* map)
 			propStream.read<uint32_t>(totalTiles);
 
 			bool hasTiles = !house->getTiles().empty();
+			bool loadedAllTiles = true;
 
 			for (uint32_t i = 0; i < totalTiles; i++) {
 				uint16_t x, y, z;
@@ -229,6 +246,7 @@ bool IOMapSerialize::loadHouseItems(Map* map)
 					std::cout << fmt::format("> WARNING: Tile no longer exists {:d}-{:d}-{:d}:{:d}", x, y, z, totalItems)
 					          << std::endl;
 					loadedHouse = false;
+					loadedAllTiles = false;
 					break;
 				}
 
@@ -280,6 +298,7 @@ bool IOMapSerialize::loadHouseItems(Map* map)
 					}
 				}
 				else {
+					loadedAllTiles = false;
 					for (Item* houseItem : preloadedItems) {
 						delete houseItem;
 					}
@@ -289,6 +308,9 @@ bool IOMapSerialize::loadHouseItems(Map* map)
 			// update house doors
 			house->updateDoorDescription();
 
+			// the file on disk matches the house now, no need to write it until something changes
+			house->setDirty(!loadedAllTiles);
+
 			fileTest.close();
 		}
 	}
@@ -302,15 +324,58 @@ bool IOMapSerialize::saveHouseItems()
 	std::cout << "> Saving house items..." << std::endl;
 	int64_t start = OTSYS_TIME();
 
-	for (const auto& it : g_game.map.houses.getHouses()) {
-		const House* house = it.second;
-		if (!saveHouseTVPFormat(house)) {
-			std::cout << "> ERROR: Failed to save house " << house->getId() << ":" << house->getName() << std::endl;
-			return false;
+	struct SaveReport {
+		size_t pending = 1;
+		size_t written = 0;
+		size_t failed = 0;
+	};
+
+	// write callbacks run on the dispatcher, whoever finishes last prints the report;
+	// the extra pending count keeps writes completed inline from reporting early
+	auto report = std::make_shared<SaveReport>();
+	auto finishWrite = [report, start]() {
+		if (--report->pending != 0) {
+			return;
+		}
+
+		std::cout << "> Saved " << report->written << " house data files";
+		if (report->failed != 0) {
+			std::cout << " (" << report->failed << " failed)";
+		}
+		std::cout << " in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+	};
+
+	size_t serializedHouses = 0;
+	const auto& houses = g_game.map.houses.getHouses();
+	for (const auto& it : houses) {
+		House* house = it.second;
+		if (!house->isDirty()) {
+			continue;
 		}
+
+		std::string data = serializeHouseTVPFormat(house);
+		house->setDirty(false);
+		++serializedHouses;
+		++report->pending;
+
+		const uint32_t houseId = house->getId();
+		g_fileWriteTasks.addTask(fmt::format("gamedata/houses/{:d}.tvph", houseId), std::move(data), [houseId, report, finishWrite](bool success) {
+			if (success) {
+				++report->written;
+			} else {
+				++report->failed;
+				if (House* house = g_game.map.houses.getHouse(houseId)) {
+					// write it again on the next save
+					house->setDirty(true);
+				}
+				std::cout << "> ERROR: Failed to save house " << houseId << '.' << std::endl;
+			}
+			finishWrite();
+		});
 	}
 
-	std::cout << "> Saved house data files in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+	std::cout << "> Serialized " << serializedHouses << " of " << houses.size() << " houses in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+	finishWrite();
 	return true;
 }
 
@@ -324,75 +389,30 @@ bool IOMapSerialize::saveMapData()
 
 	int64_t start = OTSYS_TIME();
 
-	std::ostringstream ss;
-	ss << "gamedata/map.tvpm";
-
-	std::ofstream file;
-	file.open(ss.str(), std::ios::out | std::ios::binary | std::ios::trunc);
-	if (!file.is_open()) {
-		std::cout << "> ERROR: Cannot open " << ss.str() << " for saving." << std::endl;
-		return false;
-	}
-
-	PropWriteStream f;
-
 	const auto& tiles = g_game.getTilesToSave();
 
-	f.write<uint64_t>(tiles.size());
+	std::string data;
+	appendValue<uint64_t>(data, tiles.size());
 
+	// only tiles changed since the last save are serialized again,
+	// everything else is copied from the record cached on the tile
+	size_t serializedTiles = 0;
 	for (const Tile* tile : tiles) {
-		const Position& pos = tile->getPosition();
-
-		if (dynamic_cast<const HouseTile*>(tile)) {
-			f.write<uint8_t>(MAP_TILE_HOUSE);
-		} else if (dynamic_cast<const DynamicTile*>(tile)) {
-			f.write<uint8_t>(MAP_TILE_DYNAMIC);
-		} else {
-			f.write<uint8_t>(MAP_TILE_STATIC);
-		}
-
-		f.write<uint16_t>(pos.x);
-		f.write<uint16_t>(pos.y);
-		f.write<uint8_t>(pos.z);
-
-		std::vector<const Item*> savingItems;
-
-		if (const Item* ground = tile->getGround()) {
-			savingItems.push_back(ground);
-		}
-
-		std::list<Item*> borderItems;
-		if (const auto& items = tile->getItemList()) {
-			for (auto it = items->rbegin(); it != items->rend(); it++) {
-				Item* item = (*it);
-				if (item->isAlwaysOnTop() && Item::items[item->getID()].alwaysOnTopOrder == 1) {
-					borderItems.push_front(item);
-				} else {
-					savingItems.push_back(item);
-				}
-			}
-		}
-
-		if (const HouseTile* const houseTile = dynamic_cast<const HouseTile*>(tile)) {
-			f.write<uint32_t>(houseTile->getHouse()->getId());
+		const std::string* record = tile->getCachedSaveRecord();
+		if (!record) {
+			record = &tile->setCachedSaveRecord(serializeTile(tile));
+			++serializedTiles;
 		}
 
-		uint32_t realTileFlags = tile->getFlags();
-		realTileFlags &= ~TILESTATE_FLOORCHANGE;
-
-		f.write<uint32_t>(realTileFlags);
-
-		f.write<uint32_t>(savingItems.size() + borderItems.size());
-
-		for (const Item* item : borderItems) {
-			item->serializeTVPFormat(f);
-		}
-
-		for (const Item* item : savingItems) {
-			item->serializeTVPFormat(f);
-		}
+		// flags are kept out of the record, they are not only changed by the tile items
+		size_t headerSize = static_cast<uint8_t>((*record)[0]) == MAP_TILE_HOUSE ? HOUSE_TILE_RECORD_HEADER_SIZE : TILE_RECORD_HEADER_SIZE;
+		data.append(*record, 0, headerSize);
+		appendValue<uint32_t>(data, tile->getFlags() & ~(TILESTATE_FLOORCHANGE | TILESTATE_BLOCKPROJECTILE));
+		data.append(*record, headerSize, std::string::npos);
 	}
 
+	PropWriteStream f;
+
 	f.write<uint8_t>(g_game.map.towns.getTowns().size());
 	for (const auto& it : g_game.map.towns.getTowns()) {
 		Town* town = it.second;
@@ -419,15 +439,78 @@ bool IOMapSerialize::saveMapData()
 	f.writeString(g_game.map.housefile);
 
 	size_t size;
-	const char* data = f.getStream(size);
-	file.write(data, size);
-	file.close();
+	const char* stream = f.getStream(size);
+	data.append(stream, size);
 
-	std::cout << "> Saved map data in: " <<
+	std::cout << "> Serialized map data (" << serializedTiles << " of " << tiles.size() << " tiles changed) in: " <<
 		(OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+
+	g_fileWriteTasks.addTask("gamedata/map.tvpm", std::move(data), [start](bool success) {
+		if (success) {
+			std::cout << "> Saved map data in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+		} else {
+			std::cout << "> ERROR: Failed to save map data." << std::endl;
+		}
+	});
 	return true;
 }
 
+std::string IOMapSerialize::serializeTile(const Tile* tile)
+{
+	PropWriteStream f;
+
+	const Position& pos = tile->getPosition();
+
+	const HouseTile* houseTile = dynamic_cast<const HouseTile*>(tile);
+	if (houseTile) {
+		f.write<uint8_t>(MAP_TILE_HOUSE);
+	} else if (dynamic_cast<const DynamicTile*>(tile)) {
+		f.write<uint8_t>(MAP_TILE_DYNAMIC);
+	} else {
+		f.write<uint8_t>(MAP_TILE_STATIC);
+	}
+
+	f.write<uint16_t>(pos.x);
+	f.write<uint16_t>(pos.y);
+	f.write<uint8_t>(pos.z);
+
+	if (houseTile) {
+		f.write<uint32_t>(houseTile->getHouse()->getId());
+	}
+
+	std::vector<const Item*> savingItems;
+
+	if (const Item* ground = tile->getGround()) {
+		savingItems.push_back(ground);
+	}
+
+	std::list<Item*> borderItems;
+	if (const auto& items = tile->getItemList()) {
+		for (auto it = items->rbegin(); it != items->rend(); it++) {
+			Item* item = (*it);
+			if (item->isAlwaysOnTop() && Item::items[item->getID()].alwaysOnTopOrder == 1) {
+				borderItems.push_front(item);
+			} else {
+				savingItems.push_back(item);
+			}
+		}
+	}
+
+	f.write<uint32_t>(savingItems.size() + borderItems.size());
+
+	for (const Item* item : borderItems) {
+		item->serializeTVPFormat(f);
+	}
+
+	for (const Item* item : savingItems) {
+		item->serializeTVPFormat(f);
+	}
+
+	size_t size;
+	const char* stream = f.getStream(size);
+	return std::string(stream, size);
+}
+
 bool IOMapSerialize::loadContainer(PropStream& propStream, Container* container)
 {
 	while (container->serializationCount > 0) {
@@ -725,18 +808,8 @@ bool IOMapSerialize::saveHouse(House* house)
 	return transaction.commit();
 }
 
-bool IOMapSerialize::saveHouseTVPFormat(const House* house)
+std::string IOMapSerialize::serializeHouseTVPFormat(const House* house)
 {
-	std::ostringstream ss;
-	ss << "gamedata/houses/" << house->getId() << ".tvph";
-
-	std::ofstream file;
-	file.open(ss.str(), std::ios::out | std::ios::binary | std::ios::trunc);
-	if (!file.is_open()) {
-		std::cout << "> ERROR: Cannot open " << ss.str() << " for saving." << std::endl;
-		return false;
-	}
-
 	PropWriteStream f;
 
 	f.writeString(house->getName());
@@ -774,7 +847,5 @@ bool IOMapSerialize::saveHouseTVPFormat(const House* house)
 
 	size_t size;
 	const char* data = f.getStream(size);
-	file.write(data, size);
-	file.close();
-	return true;
+	return std::string(data, size);
 }
@@ -50,11 +50,12 @@ class IOMapSerialize
 		static bool saveHouseInfo();
 
 		static bool saveHouse(House* house);
-		static bool saveHouseTVPFormat(const House* house);
+		static std::string serializeHouseTVPFormat(const House* house);
 
 	private:
 		static void saveItem(PropWriteStream& stream, const Item* item);
 		static void saveTile(PropWriteStream& stream, const Tile* tile);
+		static std::string serializeTile(const Tile* tile);
 
 		static bool loadContainer(PropStream& propStream, Container* container);
 		static bool loadItem(PropStream& propStream, Cylinder* parent);
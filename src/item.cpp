@@ -251,6 +251,8 @@ void Item::setID(uint16_t newid)
 		setDecaying(DECAYING_FALSE);
 		setDuration(newDuration);
 	}
+
+	invalidateTileCaches();
 }
 
 void Item::decrementReferenceCounter() 
@@ -334,6 +336,34 @@ const Tile* Item::getTile() const
 	return dynamic_cast<const Tile*>(cylinder);
 }
 
+void Item::invalidateTileCaches()
+{
+	// walk up through containers, items carried by creatures are not part of the map save;
+	// only items lying directly on a tile are part of its client description
+	Cylinder* cylinder = parent;
+	bool onTile = true;
+	while (cylinder && cylinder != VirtualCylinder::virtualCylinder) {
+		if (cylinder->getCreature()) {
+			return;
+		}
+
+		Cylinder* next = cylinder->getParent();
+		if (!next) {
+			if (Tile* tile = cylinder->getTile()) {
+				if (onTile) {
+					// also drops the save record
+					tile->invalidateDescription();
+				} else {
+					tile->invalidateSaveRecord();
+				}
+			}
+			return;
+		}
+		cylinder = next;
+		onTile = false;
+	}
+}
+
 uint16_t Item::getSubType() const
 {
 	const ItemType& it = items[id];
@@ -2911,6 +2941,7 @@ void Item::setUniqueId(uint32_t n)
 
 	if (g_game.addUniqueItem(n, this)) {
 		getAttributes()->setUniqueId(n);
+		invalidateTileCaches();
 	}
 }
 
@@ -701,6 +701,7 @@ class Item : virtual public Thing
 		}
 		void setStrAttr(itemAttrTypes type, const std::string& value) {
 			getAttributes()->setStrAttr(type, value);
+			invalidateTileCaches();
 		}
 
 		int64_t getIntAttr(itemAttrTypes type) const {
@@ -711,9 +712,11 @@ class Item : virtual public Thing
 		}
 		void setIntAttr(itemAttrTypes type, int64_t value) {
 			getAttributes()->setIntAttr(type, value);
+			invalidateTileCaches();
 		}
 		void increaseIntAttr(itemAttrTypes type, int64_t value) {
 			getAttributes()->increaseIntAttr(type, value);
+			invalidateTileCaches();
 		}
 		 
 		void setStoreItem(bool value) {
@@ -723,6 +726,7 @@ class Item : virtual public Thing
 			else {
 				getAttributes()->removeCustomAttribute(ITEM_CUSTOM_ATTRIBUTE_STORE);
 			}
+			invalidateTileCaches();
 		}
 
 		bool isStoreItem() const {
@@ -732,6 +736,7 @@ class Item : virtual public Thing
 		void removeAttribute(itemAttrTypes type) {
 			if (attributes) {
 				attributes->removeAttribute(type);
+				invalidateTileCaches();
 			}
 		}
 		bool hasAttribute(itemAttrTypes type) const {
@@ -749,10 +754,12 @@ class Item : virtual public Thing
 		template<typename R>
 		void setCustomAttribute(std::string& key, R value) {
 			getAttributes()->setCustomAttribute(key, value);
+			invalidateTileCaches();
 		}
 
 		void setCustomAttribute(std::string& key, ItemAttributes::CustomAttribute& value) {
 			getAttributes()->setCustomAttribute(key, value);
+			invalidateTileCaches();
 		}
 
 		const ItemAttributes::CustomAttribute* getCustomAttribute(int64_t key) {
@@ -798,6 +805,7 @@ class Item : virtual public Thing
 			if (!attributes) {
 				return false;
 			}
+			invalidateTileCaches();
 			return getAttributes()->removeCustomAttribute(key);
 		}
 
@@ -805,6 +813,7 @@ class Item : virtual public Thing
 			if (!attributes) {
 				return false;
 			}
+			invalidateTileCaches();
 			return getAttributes()->removeCustomAttribute(key);
 		}
 
@@ -1142,6 +1151,7 @@ class Item : virtual public Thing
 		}
 		void setItemCount(uint8_t n) {
 			count = n;
+			invalidateTileCaches();
 		}
 
 		static uint32_t countByType(const Item* i, int32_t subType) {
@@ -1201,6 +1211,8 @@ class Item : virtual public Thing
 		const Cylinder* getTopParent() const;
 		Tile* getTile() override;
 		const Tile* getTile() const override;
+		// called by every change that shows in the client description or the map save of the tile below
+		void invalidateTileCaches();
 		bool isRemoved() const override {
 			return !parent || parent->isRemoved();
 		}
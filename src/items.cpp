@@ -20,15 +20,155 @@
 #include "otpch.h"
 
 #include "items.h"
+#include "filewritetasks.h"
 #include "spells.h"
 #include "movement.h"
 #include "weapons.h"
 
 #include "pugicast.h"
 
+#include <fstream>
+
 extern MoveEvents* g_moveEvents;
 extern Weapons* g_weapons;
 
+namespace {
+
+const std::string ITEMS_CACHE_FILE = "data/items/items.bin";
+
+#pragma pack(1)
+
+// the struct sizes invalidate caches written by a build with a different ItemType layout,
+// bump the version when a field changes meaning without changing the size
+struct ItemsCacheHeader {
+	char magic[4] = {'I', 'T', 'M', 'C'};
+	uint32_t version = 1;
+	uint32_t itemTypeSize = sizeof(ItemType);
+	uint32_t abilitiesSize = sizeof(Abilities);
+
+	bool operator!=(const ItemsCacheHeader& other) const {
+		return memcmp(this, &other, sizeof(ItemsCacheHeader)) != 0;
+	}
+};
+
+#pragma pack()
+
+static_assert(std::is_trivially_copyable<Abilities>::value, "Abilities is stored in the items cache as raw bytes");
+
+class ItemsCacheWriter
+{
+	public:
+		explicit ItemsCacheWriter(PropWriteStream& propWriteStream) : propWriteStream(propWriteStream) {}
+
+		template<typename T>
+		bool operator()(T& value) {
+			propWriteStream.write<T>(value);
+			return true;
+		}
+
+		bool operator()(std::string& value) {
+			propWriteStream.writeString(value);
+			return true;
+		}
+
+		bool operator()(std::unique_ptr<Abilities>& abilities) {
+			propWriteStream.write<bool>(abilities != nullptr);
+			if (abilities) {
+				propWriteStream.write<Abilities>(*abilities);
+			}
+			return true;
+		}
+
+		bool operator()(std::unique_ptr<ConditionDamage>& conditionDamage) {
+			propWriteStream.write<bool>(conditionDamage != nullptr);
+			if (conditionDamage) {
+				conditionDamage->serializeDefinition(propWriteStream);
+			}
+			return true;
+		}
+
+	private:
+		PropWriteStream& propWriteStream;
+};
+
+class ItemsCacheReader
+{
+	public:
+		explicit ItemsCacheReader(PropStream& propStream) : propStream(propStream) {}
+
+		template<typename T>
+		bool operator()(T& value) {
+			return propStream.read<T>(value);
+		}
+
+		bool operator()(std::string& value) {
+			return propStream.readString(value);
+		}
+
+		bool operator()(std::unique_ptr<Abilities>& abilities) {
+			bool present;
+			if (!propStream.read<bool>(present)) {
+				return false;
+			}
+
+			if (present) {
+				abilities.reset(new Abilities());
+				return propStream.read<Abilities>(*abilities);
+			}
+			return true;
+		}
+
+		bool operator()(std::unique_ptr<ConditionDamage>& conditionDamage) {
+			bool present;
+			if (!propStream.read<bool>(present)) {
+				return false;
+			}
+
+			if (present) {
+				conditionDamage.reset(ConditionDamage::unserializeDefinition(propStream));
+				return conditionDamage != nullptr;
+			}
+			return true;
+		}
+
+	private:
+		PropStream& propStream;
+};
+
+// single field list for both directions, so the reader cannot drift from the writer
+template<typename Archive>
+bool transferItemType(Archive& archive, ItemType& it)
+{
+	return archive(it.group) && archive(it.type) && archive(it.id) && archive(it.clientId) && archive(it.stackable) &&
+		archive(it.name) && archive(it.article) && archive(it.pluralName) && archive(it.description) &&
+		archive(it.runeSpellName) && archive(it.vocationString) &&
+		archive(it.abilities) && archive(it.conditionDamage) &&
+		archive(it.attackSpeed) && archive(it.weight) && archive(it.levelDoor) && archive(it.decayTime) &&
+		archive(it.wieldInfo) && archive(it.minReqLevel) && archive(it.minReqMagicLevel) && archive(it.charges) &&
+		archive(it.decayTo) && archive(it.attack) && archive(it.defense) && archive(it.extraDefense) &&
+		archive(it.armor) && archive(it.rotateTo) && archive(it.runeMagLevel) && archive(it.runeLevel) &&
+		archive(it.combatType) &&
+		archive(it.transformToOnUse[0]) && archive(it.transformToOnUse[1]) && archive(it.transformToFree) &&
+		archive(it.destroyTo) && archive(it.maxTextLen) && archive(it.writeOnceItemId) &&
+		archive(it.transformEquipTo) && archive(it.transformDeEquipTo) && archive(it.maxItems) &&
+		archive(it.slotPosition) && archive(it.speed) && archive(it.wareId) &&
+		archive(it.magicEffect) && archive(it.bedPartnerDir) && archive(it.weaponType) && archive(it.ammoType) &&
+		archive(it.shootType) && archive(it.corpseType) && archive(it.fluidSource) &&
+		archive(it.floorChange) && archive(it.alwaysOnTopOrder) && archive(it.lightLevel) && archive(it.rarityTier) &&
+		archive(it.lightColor) && archive(it.shootRange) && archive(it.hitChance) && archive(it.missileType) &&
+		archive(it.isCrossbow) && archive(it.isBow) && archive(it.specialFieldBlockPath) && archive(it.replaceMagicFields) &&
+		archive(it.forceUse) && archive(it.forceSerialize) && archive(it.hasHeight) && archive(it.blockSolid) &&
+		archive(it.blockPickupable) && archive(it.blockProjectile) && archive(it.blockPathFind) &&
+		archive(it.allowPickupable) && archive(it.showDuration) && archive(it.showCharges) &&
+		archive(it.showAttributes) && archive(it.replaceable) && archive(it.pickupable) && archive(it.rotatable) &&
+		archive(it.useable) && archive(it.moveable) && archive(it.alwaysOnTop) && archive(it.canReadText) &&
+		archive(it.canWriteText) && archive(it.isVertical) && archive(it.isHorizontal) && archive(it.isHangable) &&
+		archive(it.allowDistRead) && archive(it.lookThrough) && archive(it.stopTime) && archive(it.showCount) &&
+		archive(it.storeItem);
+}
+
+}
+
 const std::unordered_map<std::string, ItemParseAttributes_t> ItemParseAttributesMap = {
 	{"type", ITEM_PARSE_TYPE},
 	{"group", ITEM_PARSE_GROUP},
@@ -278,9 +418,18 @@ bool Items::reload()
 
 bool Items::loadFromXml()
 {
+	std::ifstream xmlFile("data/items/items.xml", std::ios::binary);
+	std::string xmlContents{std::istreambuf_iterator<char>(xmlFile), std::istreambuf_iterator<char>()};
+	const std::string xmlHash = transformToSHA1(xmlContents);
+
+	if (xmlFile.is_open() && loadFromCache(ITEMS_CACHE_FILE, xmlHash)) {
+		buildInventoryList();
+		return true;
+	}
+
 	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file("data/items/items.xml");
-	if (!result) {
+	pugi::xml_parse_result result = doc.load_buffer(xmlContents.data(), xmlContents.size());
+	if (!xmlFile.is_open() || !result) {
 		printXMLError("Error - Items::loadFromXml", "data/items/items.xml", result);
 		return false;
 	}
@@ -317,10 +466,114 @@ bool Items::loadFromXml()
 	//doc.save_file("data/items/items.xml");
 	
 
+	saveToCache(ITEMS_CACHE_FILE, xmlHash);
+
 	buildInventoryList();
 	return true;
 }
 
+bool Items::loadFromCache(const std::string& fileName, const std::string& hash)
+{
+	boost::iostreams::mapped_file_source file;
+	try {
+		file.open(fileName);
+	} catch (const std::exception&) {
+		return false;
+	}
+
+	PropStream propStream;
+	propStream.init(file.data(), file.size());
+
+	ItemsCacheHeader header;
+	std::string cachedHash;
+	if (!propStream.read(header) || header != ItemsCacheHeader() || !propStream.readString(cachedHash) || cachedHash != hash) {
+		return false;
+	}
+
+	std::vector<ItemType> cachedItems;
+	NameMap cachedNames;
+	std::vector<uint16_t> cachedServerIds;
+
+	uint32_t count;
+	if (!propStream.read<uint32_t>(count)) {
+		return false;
+	}
+
+	cachedItems.resize(count);
+	ItemsCacheReader reader(propStream);
+	for (ItemType& it : cachedItems) {
+		if (!transferItemType(reader, it)) {
+			return false;
+		}
+	}
+
+	if (!propStream.read<uint32_t>(count)) {
+		return false;
+	}
+
+	cachedNames.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		std::string name;
+		uint16_t id;
+		if (!propStream.readString(name) || !propStream.read<uint16_t>(id)) {
+			return false;
+		}
+		cachedNames.emplace(std::move(name), id);
+	}
+
+	if (!propStream.read<uint32_t>(count)) {
+		return false;
+	}
+
+	cachedServerIds.resize(count);
+	for (uint16_t& serverId : cachedServerIds) {
+		if (!propStream.read<uint16_t>(serverId)) {
+			return false;
+		}
+	}
+
+	if (propStream.size() != 0) {
+		return false;
+	}
+
+	items = std::move(cachedItems);
+	nameToItems = std::move(cachedNames);
+	clientIdToServerIdMap.setServerIds(std::move(cachedServerIds));
+	return true;
+}
+
+void Items::saveToCache(const std::string& fileName, const std::string& hash)
+{
+	PropWriteStream propWriteStream;
+	propWriteStream.write(ItemsCacheHeader());
+	propWriteStream.writeString(hash);
+
+	propWriteStream.write<uint32_t>(items.size());
+	ItemsCacheWriter writer(propWriteStream);
+	for (ItemType& it : items) {
+		transferItemType(writer, it);
+	}
+
+	propWriteStream.write<uint32_t>(nameToItems.size());
+	for (const auto& it : nameToItems) {
+		propWriteStream.writeString(it.first);
+		propWriteStream.write<uint16_t>(it.second);
+	}
+
+	const std::vector<uint16_t>& serverIds = clientIdToServerIdMap.getServerIds();
+	propWriteStream.write<uint32_t>(serverIds.size());
+	for (uint16_t serverId : serverIds) {
+		propWriteStream.write<uint16_t>(serverId);
+	}
+
+	// written aside and renamed over the old cache, a crash mid-write must not leave a truncated cache behind
+	size_t size;
+	const char* data = propWriteStream.getStream(size);
+	if (!FileWriteTasks::writeFile(fileName, std::string(data, size))) {
+		std::cout << "[Warning - Items::saveToCache] Unable to write " << fileName << '.' << std::endl;
+	}
+}
+
 void Items::buildInventoryList()
 {
 	inventory.reserve(items.size());
@@ -473,6 +473,10 @@ class Items
 		NameMap nameToItems;
 
 	private:
+		// compiled copy of items.xml, rebuilt whenever the xml hash changes
+		bool loadFromCache(const std::string& fileName, const std::string& hash);
+		void saveToCache(const std::string& fileName, const std::string& hash);
+
 		std::vector<ItemType> items;
 		InventoryVector inventory;
 		class ClientIdToServerIdMap
@@ -502,6 +506,13 @@ class Items
 				void clear() {
 					vec.clear();
 				}
+
+				const std::vector<uint16_t>& getServerIds() const {
+					return vec;
+				}
+				void setServerIds(std::vector<uint16_t> serverIds) {
+					vec = std::move(serverIds);
+				}
 			private:
 				std::vector<uint16_t> vec;
 		} clientIdToServerIdMap;
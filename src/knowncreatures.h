@@ -0,0 +1,141 @@
+/**
+ * The Violet Project - a free and open-source MMORPG server emulator
+ * Copyright (C) 2021 - Ezzz <alejandromujica.rsm@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef FS_KNOWNCREATURES_H_3E8C2A7B5D1F4E6A9C0B8D7E6F5A4B3C
+#define FS_KNOWNCREATURES_H_3E8C2A7B5D1F4E6A9C0B8D7E6F5A4B3C
+
+#include <array>
+#include <cstdint>
+
+// Creatures the client already has the full description of. The client keeps at most
+// MAX_KNOWN_CREATURES of them, once full a new creature replaces one in clock order
+// (least recently used first) that the evict predicate accepts.
+class KnownCreatureTable
+{
+	public:
+		static constexpr size_t MAX_KNOWN_CREATURES = 150;
+
+		KnownCreatureTable() {
+			slots.fill(EMPTY_SLOT);
+		}
+
+		// marks id as recently used, false if it is not known
+		bool touch(uint32_t id) {
+			size_t slot = findSlot(id);
+			if (slots[slot] == EMPTY_SLOT) {
+				return false;
+			}
+
+			referenced[slots[slot]] = true;
+			return true;
+		}
+
+		bool full() const {
+			return count == MAX_KNOWN_CREATURES;
+		}
+
+		void insert(uint32_t id) {
+			ids[count] = id;
+			referenced[count] = true;
+			slots[findSlot(id)] = static_cast<uint8_t>(count++);
+		}
+
+		// replaces the first entry from the clock hand that canEvict accepts, entries passed
+		// over get a second chance so every entry is checked at most once; when no entry
+		// qualifies the one under the hand goes anyway. Returns the evicted id.
+		template <typename Predicate>
+		uint32_t replace(uint32_t id, Predicate canEvict) {
+			size_t victim = MAX_KNOWN_CREATURES;
+			for (size_t i = 0; i < MAX_KNOWN_CREATURES * 2; ++i) {
+				size_t entry = advanceHand();
+				if (referenced[entry]) {
+					referenced[entry] = false;
+				} else if (canEvict(ids[entry])) {
+					victim = entry;
+					break;
+				} else {
+					referenced[entry] = true;
+				}
+			}
+
+			if (victim == MAX_KNOWN_CREATURES) {
+				victim = advanceHand();
+			}
+
+			uint32_t removed = ids[victim];
+			eraseSlot(findSlot(removed));
+
+			ids[victim] = id;
+			referenced[victim] = true;
+			slots[findSlot(id)] = static_cast<uint8_t>(victim);
+			return removed;
+		}
+
+	private:
+		// power of two above MAX_KNOWN_CREATURES keeping the probe sequences short
+		static constexpr size_t SLOT_COUNT = 256;
+		static constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+		static size_t hash(uint32_t id) {
+			return (id * 2654435761u) >> 24;
+		}
+
+		// slot holding id, or the empty slot where it would be inserted
+		size_t findSlot(uint32_t id) const {
+			size_t slot = hash(id);
+			while (slots[slot] != EMPTY_SLOT && ids[slots[slot]] != id) {
+				slot = (slot + 1) & (SLOT_COUNT - 1);
+			}
+			return slot;
+		}
+
+		// backward shift deletion, keeps every remaining id reachable from its home slot
+		void eraseSlot(size_t slot) {
+			size_t next = slot;
+			while (true) {
+				next = (next + 1) & (SLOT_COUNT - 1);
+				if (slots[next] == EMPTY_SLOT) {
+					break;
+				}
+
+				size_t home = hash(ids[slots[next]]);
+				if (((next - home) & (SLOT_COUNT - 1)) >= ((next - slot) & (SLOT_COUNT - 1))) {
+					slots[slot] = slots[next];
+					slot = next;
+				}
+			}
+			slots[slot] = EMPTY_SLOT;
+		}
+
+		size_t advanceHand() {
+			size_t entry = hand;
+			if (++hand == MAX_KNOWN_CREATURES) {
+				hand = 0;
+			}
+			return entry;
+		}
+
+		std::array<uint32_t, MAX_KNOWN_CREATURES> ids;
+		std::array<bool, MAX_KNOWN_CREATURES> referenced;
+		std::array<uint8_t, SLOT_COUNT> slots;
+		size_t count = 0;
+		size_t hand = 0;
+};
+
+#endif
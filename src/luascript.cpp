@@ -934,6 +934,18 @@ uint64_t LuaScriptInterface::getFieldUnsigned(lua_State* L, const char* key)
 	return result;
 }
 
+bool LuaScriptInterface::isUserdataClass(lua_State* L, int32_t arg, const char* className)
+{
+	if (!isUserdata(L, arg) || lua_getmetatable(L, arg) == 0) {
+		return false;
+	}
+
+	luaL_getmetatable(L, className);
+	bool result = lua_rawequal(L, -1, -2) != 0;
+	lua_pop(L, 2);
+	return result;
+}
+
 LuaDataType LuaScriptInterface::getUserdataType(lua_State* L, int32_t arg)
 {
 	if (lua_getmetatable(L, arg) == 0) {
@@ -1422,6 +1434,20 @@ void LuaScriptInterface::registerFunctions()
 	registerMethod("NetworkMessage", "skipBytes", LuaScriptInterface::luaNetworkMessageSkipBytes);
 	registerMethod("NetworkMessage", "sendToPlayer", LuaScriptInterface::luaNetworkMessageSendToPlayer);
 
+	// NetworkMessageView, the payload of a received packet lent to onBinaryOpcode, the server keeps ownership
+	registerClass("NetworkMessageView", "");
+	registerMetaMethod("NetworkMessageView", "__eq", LuaScriptInterface::luaUserdataCompare);
+	registerMethod("NetworkMessageView", "delete", LuaScriptInterface::luaNetworkMessageViewDelete);
+
+	registerMethod("NetworkMessageView", "getByte", LuaScriptInterface::luaNetworkMessageViewGetByte);
+	registerMethod("NetworkMessageView", "getU16", LuaScriptInterface::luaNetworkMessageViewGetU16);
+	registerMethod("NetworkMessageView", "getU32", LuaScriptInterface::luaNetworkMessageViewGetU32);
+	registerMethod("NetworkMessageView", "getU64", LuaScriptInterface::luaNetworkMessageViewGetU64);
+	registerMethod("NetworkMessageView", "getString", LuaScriptInterface::luaNetworkMessageViewGetString);
+	registerMethod("NetworkMessageView", "getPosition", LuaScriptInterface::luaNetworkMessageViewGetPosition);
+	registerMethod("NetworkMessageView", "tell", LuaScriptInterface::luaNetworkMessageViewTell);
+	registerMethod("NetworkMessageView", "len", LuaScriptInterface::luaNetworkMessageViewLength);
+
 	// Item
 	registerClass("Item", "", LuaScriptInterface::luaItemCreate);
 	registerMetaMethod("Item", "__eq", LuaScriptInterface::luaUserdataCompare);
@@ -1695,6 +1721,7 @@ void LuaScriptInterface::registerFunctions()
 	registerMethod("Player", "showTextDialog", LuaScriptInterface::luaPlayerShowTextDialog);
 
 	registerMethod("Player", "sendTextMessage", LuaScriptInterface::luaPlayerSendTextMessage);
+	registerMethod("Player", "sendBinaryOpcode", LuaScriptInterface::luaPlayerSendBinaryOpcode);
 	registerMethod("Player", "sendChannelMessage", LuaScriptInterface::luaPlayerSendChannelMessage);
 	registerMethod("Player", "sendPrivateMessage", LuaScriptInterface::luaPlayerSendPrivateMessage);
 	registerMethod("Player", "channelSay", LuaScriptInterface::luaPlayerChannelSay);
@@ -2301,6 +2328,7 @@ void LuaScriptInterface::registerFunctions()
 	registerMethod("CreatureEvent", "onHealthChange", LuaScriptInterface::luaCreatureEventOnCallback);
 	registerMethod("CreatureEvent", "onManaChange", LuaScriptInterface::luaCreatureEventOnCallback);
 	registerMethod("CreatureEvent", "onExtendedOpcode", LuaScriptInterface::luaCreatureEventOnCallback);
+	registerMethod("CreatureEvent", "onBinaryOpcode", LuaScriptInterface::luaCreatureEventOnCallback);
 
 	// MoveEvent
 	registerClass("MoveEvent", "", LuaScriptInterface::luaCreateMoveEvent);
@@ -2790,6 +2818,7 @@ void LuaScriptInterface::registerEnums(lua_State* L)
 	REGISTER_ENUM(L, CREATURE_EVENT_HEALTHCHANGE);
 	REGISTER_ENUM(L, CREATURE_EVENT_MANACHANGE);
 	REGISTER_ENUM(L, CREATURE_EVENT_EXTENDED_OPCODE);
+	REGISTER_ENUM(L, CREATURE_EVENT_BINARY_OPCODE);
 
 	REGISTER_ENUM(L, GAME_STATE_STARTUP);
 	REGISTER_ENUM(L, GAME_STATE_INIT);
@@ -5873,6 +5902,112 @@ int LuaScriptInterface::luaNetworkMessageDelete(lua_State* L)
 	return 0;
 }
 
+int LuaScriptInterface::luaNetworkMessageViewDelete(lua_State* L)
+{
+	// networkMessageView:delete(), only detaches the view
+	NetworkMessageView** messagePtr = getRawUserdata<NetworkMessageView>(L, 1);
+	if (messagePtr) {
+		*messagePtr = nullptr;
+	}
+	return 0;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewGetByte(lua_State* L)
+{
+	// networkMessageView:getByte()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		lua_pushnumber(L, message->getByte());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewGetU16(lua_State* L)
+{
+	// networkMessageView:getU16()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		lua_pushnumber(L, message->get<uint16_t>());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewGetU32(lua_State* L)
+{
+	// networkMessageView:getU32()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		lua_pushnumber(L, message->get<uint32_t>());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewGetU64(lua_State* L)
+{
+	// networkMessageView:getU64()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		lua_pushnumber(L, message->get<uint64_t>());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewGetString(lua_State* L)
+{
+	// networkMessageView:getString()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		pushString(L, message->getString());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewGetPosition(lua_State* L)
+{
+	// networkMessageView:getPosition()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		pushPosition(L, message->getPosition());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewTell(lua_State* L)
+{
+	// networkMessageView:tell()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		lua_pushnumber(L, message->getReadPosition());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaNetworkMessageViewLength(lua_State* L)
+{
+	// networkMessageView:len()
+	NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 1);
+	if (message) {
+		lua_pushnumber(L, message->getSize());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
 int LuaScriptInterface::luaNetworkMessageGetByte(lua_State* L)
 {
 	// networkMessage:getByte()
@@ -6714,6 +6849,7 @@ int LuaScriptInterface::luaItemRemoveCustomAttribute(lua_State* L) {
 		pushBoolean(L, item->removeCustomAttribute(getString(L, 2)));
 	} else {
 		lua_pushnil(L);
+		return 1;
 	}
 	return 1;
 }
@@ -9600,6 +9736,40 @@ int LuaScriptInterface::luaPlayerSendTextMessage(lua_State* L)
 	return 1;
 }
 
+int LuaScriptInterface::luaPlayerSendBinaryOpcode(lua_State* L)
+{
+	// player:sendBinaryOpcode(opcode, networkMessage or networkMessageView)
+	Player* player = getUserdata<Player>(L, 1);
+	if (!player) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	uint8_t opcode = getNumber<uint8_t>(L, 2);
+	if (isUserdataClass(L, 3, "NetworkMessage")) {
+		NetworkMessage* message = getUserdata<NetworkMessage>(L, 3);
+		if (!message) {
+			lua_pushnil(L);
+			return 1;
+		}
+		player->sendBinaryOpcode(opcode, *message);
+	} else if (isUserdataClass(L, 3, "NetworkMessageView")) {
+		// forwards the whole payload, whatever the script already read
+		NetworkMessageView* message = getUserdata<NetworkMessageView>(L, 3);
+		if (!message) {
+			lua_pushnil(L);
+			return 1;
+		}
+		player->sendBinaryOpcode(opcode, *message);
+	} else {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	pushBoolean(L, true);
+	return 1;
+}
+
 int LuaScriptInterface::luaPlayerSendChannelMessage(lua_State* L)
 {
 	// player:sendChannelMessage(author, text, type, channelId)
@@ -16678,6 +16848,8 @@ int LuaScriptInterface::luaCreatureEventType(lua_State* L)
 			creature->setEventType(CREATURE_EVENT_MANACHANGE);
 		} else if (tmpStr == "extendedopcode") {
 			creature->setEventType(CREATURE_EVENT_EXTENDED_OPCODE);
+		} else if (tmpStr == "binaryopcode") {
+			creature->setEventType(CREATURE_EVENT_BINARY_OPCODE);
 		} else {
 			std::cout << "[Error - CreatureEvent::configureLuaEvent] Invalid type for creature event: " << typeName << std::endl;
 			pushBoolean(L, false);
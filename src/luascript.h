@@ -395,6 +395,8 @@ class LuaScriptInterface
 		{
 			return lua_isuserdata(L, arg) != 0;
 		}
+		// exact class check, for arguments whose C++ type cannot be told apart by getUserdataType
+		static bool isUserdataClass(lua_State* L, int32_t arg, const char* className);
 
 		// Push
 		static void pushBoolean(lua_State* L, bool value);
@@ -708,6 +710,18 @@ class LuaScriptInterface
 		static int luaNetworkMessageSkipBytes(lua_State* L);
 		static int luaNetworkMessageSendToPlayer(lua_State* L);
 
+		// NetworkMessageView
+		static int luaNetworkMessageViewDelete(lua_State* L);
+
+		static int luaNetworkMessageViewGetByte(lua_State* L);
+		static int luaNetworkMessageViewGetU16(lua_State* L);
+		static int luaNetworkMessageViewGetU32(lua_State* L);
+		static int luaNetworkMessageViewGetU64(lua_State* L);
+		static int luaNetworkMessageViewGetString(lua_State* L);
+		static int luaNetworkMessageViewGetPosition(lua_State* L);
+		static int luaNetworkMessageViewTell(lua_State* L);
+		static int luaNetworkMessageViewLength(lua_State* L);
+
 		// Item
 		static int luaItemCreate(lua_State* L);
 
@@ -972,6 +986,7 @@ class LuaScriptInterface
 		static int luaPlayerShowTextDialog(lua_State* L);
 
 		static int luaPlayerSendTextMessage(lua_State* L);
+		static int luaPlayerSendBinaryOpcode(lua_State* L);
 		static int luaPlayerSendChannelMessage(lua_State* L);
 		static int luaPlayerSendPrivateMessage(lua_State* L);
 
@@ -26,8 +26,67 @@
 #include "game.h"
 #include "monster.h"
 
+#include <queue>
+
 extern Game g_game;
 
+uint64_t SpectatorVec::epoch = 0;
+
+void SpectatorVec::addSpectators(const SpectatorVec& spectators)
+{
+	if (spectators.vec.empty()) {
+		return;
+	}
+
+	// stamp everything already present, then append whatever is unstamped
+	const uint64_t mark = ++epoch;
+	for (Creature* spectator : vec) {
+		spectator->spectatorMark = mark;
+	}
+
+	for (Creature* spectator : spectators.vec) {
+		if (spectator->spectatorMark == mark) {
+			continue;
+		}
+		spectator->spectatorMark = mark;
+		vec.emplace_back(spectator);
+	}
+}
+
+namespace {
+
+constexpr size_t SPECTATOR_FILTER_CHUNK = 64;
+
+void collectSpectators(SpectatorVec& spectators, const SectorCreatureList& list, int32_t centerZ, int32_t min_x, int32_t max_x, int32_t min_y, int32_t max_y, int32_t minRangeZ, int32_t maxRangeZ)
+{
+	const size_t count = list.size();
+	const uint16_t* xs = list.x.data();
+	const uint16_t* ys = list.y.data();
+	const uint8_t* zs = list.z.data();
+
+	// the range test is branch free so the compiler can vectorize it,
+	// only the compaction into the result branches
+	uint8_t keep[SPECTATOR_FILTER_CHUNK];
+	for (size_t base = 0; base < count; base += SPECTATOR_FILTER_CHUNK) {
+		const size_t n = std::min<size_t>(count - base, SPECTATOR_FILTER_CHUNK);
+		for (size_t i = 0; i < n; ++i) {
+			int32_t z = zs[base + i];
+			int32_t offsetZ = centerZ - z;
+			int32_t x = xs[base + i] - offsetZ;
+			int32_t y = ys[base + i] - offsetZ;
+			keep[i] = (z >= minRangeZ) & (z <= maxRangeZ) & (x >= min_x) & (x <= max_x) & (y >= min_y) & (y <= max_y);
+		}
+
+		for (size_t i = 0; i < n; ++i) {
+			if (keep[i]) {
+				spectators.emplace_back(list.creatures[base + i]);
+			}
+		}
+	}
+}
+
+}
+
 bool Map::loadMap(const std::string& identifier, bool loadHouses)
 {
 	IOMap loader;
@@ -110,7 +169,7 @@ Tile* Map::getTile(uint16_t x, uint16_t y, uint8_t z) const
 		return nullptr;
 	}
 
-	const QTreeLeafNode* leaf = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, x, y);
+	const QTreeLeafNode* leaf = sectors.get(x, y);
 	if (!leaf) {
 		return nullptr;
 	}
@@ -133,26 +192,28 @@ void Map::setTile(uint16_t x, uint16_t y, uint8_t z, Tile* newTile, bool replace
 	QTreeLeafNode* leaf = root.createLeaf(x, y, 15);
 
 	if (QTreeLeafNode::newLeaf) {
+		sectors.set(x, y, leaf);
+
 		//update north
-		QTreeLeafNode* northLeaf = root.getLeaf(x, y - FLOOR_SIZE);
+		QTreeLeafNode* northLeaf = sectors.get(x, y - FLOOR_SIZE);
 		if (northLeaf) {
 			northLeaf->leafS = leaf;
 		}
 
 		//update west leaf
-		QTreeLeafNode* westLeaf = root.getLeaf(x - FLOOR_SIZE, y);
+		QTreeLeafNode* westLeaf = sectors.get(x - FLOOR_SIZE, y);
 		if (westLeaf) {
 			westLeaf->leafE = leaf;
 		}
 
 		//update south
-		QTreeLeafNode* southLeaf = root.getLeaf(x, y + FLOOR_SIZE);
+		QTreeLeafNode* southLeaf = sectors.get(x, y + FLOOR_SIZE);
 		if (southLeaf) {
 			leaf->leafS = southLeaf;
 		}
 
 		//update east
-		QTreeLeafNode* eastLeaf = root.getLeaf(x + FLOOR_SIZE, y);
+		QTreeLeafNode* eastLeaf = sectors.get(x + FLOOR_SIZE, y);
 		if (eastLeaf) {
 			leaf->leafE = eastLeaf;
 		}
@@ -185,6 +246,7 @@ void Map::setTile(uint16_t x, uint16_t y, uint8_t z, Tile* newTile, bool replace
 		delete newTile;
 	} else {
 		tile = newTile;
+		updateWalkability(tile);
 
 		if (tile->hasFlag(TILESTATE_REFRESH)) {
 			g_game.addTileToRefresh(tile);
@@ -200,7 +262,7 @@ void Map::removeTile(uint16_t x, uint16_t y, uint8_t z)
 		return;
 	}
 
-	const QTreeLeafNode* leaf = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, x, y);
+	const QTreeLeafNode* leaf = sectors.get(x, y);
 	if (!leaf) {
 		return;
 	}
@@ -317,18 +379,20 @@ void Map::moveCreature(Creature& creature, Tile& newTile, bool forceTeleport/* =
 	//remove the creature
 	oldTile.removeThing(&creature, 0);
 
+	//add the creature
+	newTile.addThing(&creature);
+
 	QTreeLeafNode* leaf = getQTNode(oldPos.x, oldPos.y);
 	QTreeLeafNode* new_leaf = getQTNode(newPos.x, newPos.y);
 
-	// Switch the node ownership
+	// Switch the node ownership, the leaf mirrors the new position
 	if (leaf != new_leaf) {
 		leaf->removeCreature(&creature);
 		new_leaf->addCreature(&creature);
+	} else {
+		leaf->updateCreature(&creature);
 	}
 
-	//add the creature
-	newTile.addThing(&creature);
-
 	if (!teleport) {
 		if (oldPos.y > newPos.y) {
 			creature.setDirection(DIRECTION_NORTH);
@@ -396,7 +460,7 @@ void Map::getSpectatorsInternal(SpectatorVec& spectators, const Position& center
 	int32_t endx2 = x2 - (x2 % FLOOR_SIZE);
 	int32_t endy2 = y2 - (y2 % FLOOR_SIZE);
 
-	const QTreeLeafNode* startLeaf = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, startx1, starty1);
+	const QTreeLeafNode* startLeaf = sectors.get(startx1, starty1);
 	const QTreeLeafNode* leafS = startLeaf;
 	const QTreeLeafNode* leafE;
 
@@ -404,30 +468,18 @@ void Map::getSpectatorsInternal(SpectatorVec& spectators, const Position& center
 		leafE = leafS;
 		for (int_fast32_t nx = startx1; nx <= endx2; nx += FLOOR_SIZE) {
 			if (leafE) {
-				const CreatureVector& node_list = (onlyPlayers ? leafE->player_list : leafE->creature_list);
-				for (Creature* creature : node_list) {
-					const Position& cpos = creature->getPosition();
-					if (minRangeZ > cpos.z || maxRangeZ < cpos.z) {
-						continue;
-					}
-
-					int_fast16_t offsetZ = Position::getOffsetZ(centerPos, cpos);
-					if ((min_y + offsetZ) > cpos.y || (max_y + offsetZ) < cpos.y || (min_x + offsetZ) > cpos.x || (max_x + offsetZ) < cpos.x) {
-						continue;
-					}
-
-					spectators.emplace_back(creature);
-				}
+				const SectorCreatureList& node_list = (onlyPlayers ? leafE->player_list : leafE->creature_list);
+				collectSpectators(spectators, node_list, centerPos.getZ(), min_x, max_x, min_y, max_y, minRangeZ, maxRangeZ);
 				leafE = leafE->leafE;
 			} else {
-				leafE = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, nx + FLOOR_SIZE, ny);
+				leafE = sectors.get(nx + FLOOR_SIZE, ny);
 			}
 		}
 
 		if (leafS) {
 			leafS = leafS->leafS;
 		} else {
-			leafS = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, startx1, ny + FLOOR_SIZE);
+			leafS = sectors.get(startx1, ny + FLOOR_SIZE);
 		}
 	}
 }
@@ -448,12 +500,11 @@ void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, boo
 
 	if (minRangeX == -maxViewportX && maxRangeX == maxViewportX && minRangeY == -maxViewportY && maxRangeY == maxViewportY && multifloor) {
 		if (onlyPlayers) {
-			auto it = playersSpectatorCache.find(centerPos);
-			if (it != playersSpectatorCache.end()) {
+			if (const SpectatorVec* cachedSpectators = findCachedSpectators(playersSpectatorCache, centerPos)) {
 				if (!spectators.empty()) {
-					spectators.addSpectators(it->second);
+					spectators.addSpectators(*cachedSpectators);
 				} else {
-					spectators = it->second;
+					spectators = *cachedSpectators;
 				}
 
 				foundCache = true;
@@ -461,18 +512,15 @@ void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, boo
 		}
 
 		if (!foundCache) {
-			auto it = spectatorCache.find(centerPos);
-			if (it != spectatorCache.end()) {
+			if (const SpectatorVec* cachedSpectators = findCachedSpectators(spectatorCache, centerPos)) {
 				if (!onlyPlayers) {
 					if (!spectators.empty()) {
-						const SpectatorVec& cachedSpectators = it->second;
-						spectators.addSpectators(cachedSpectators);
+						spectators.addSpectators(*cachedSpectators);
 					} else {
-						spectators = it->second;
+						spectators = *cachedSpectators;
 					}
 				} else {
-					const SpectatorVec& cachedSpectators = it->second;
-					for (Creature* spectator : cachedSpectators) {
+					for (Creature* spectator : *cachedSpectators) {
 						if (spectator->getPlayer()) {
 							spectators.emplace_back(spectator);
 						}
@@ -484,9 +532,18 @@ void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, boo
 				cacheResult = true;
 			}
 		}
+
+		if (foundCache) {
+			++spectatorCacheHits;
+		} else {
+			++spectatorCacheMisses;
+		}
 	}
 
 	if (!foundCache) {
+#ifdef STATS_ENABLED
+		AutoStat stat("Map::getSpectatorsInternal");
+#endif
 		int32_t minRangeZ;
 		int32_t maxRangeZ;
 
@@ -513,23 +570,69 @@ void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, boo
 		getSpectatorsInternal(spectators, centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers);
 
 		if (cacheResult) {
-			if (onlyPlayers) {
-				playersSpectatorCache[centerPos] = spectators;
-			} else {
-				spectatorCache[centerPos] = spectators;
+			SectorSpectatorCache& cache = (onlyPlayers ? playersSpectatorCache : spectatorCache);
+			uint32_t sectorKey = getSectorKey(centerPos.x >> FLOOR_BITS, centerPos.y >> FLOOR_BITS);
+			if (cache.size() >= maxSpectatorCacheSectors && cache.find(sectorKey) == cache.end()) {
+				cache.clear();
 			}
+			cache[sectorKey][centerPos] = spectators;
 		}
 	}
 }
 
-void Map::clearSpectatorCache()
+const SpectatorVec* Map::findCachedSpectators(const SectorSpectatorCache& cache, const Position& centerPos)
+{
+	auto sectorIt = cache.find(getSectorKey(centerPos.x >> FLOOR_BITS, centerPos.y >> FLOOR_BITS));
+	if (sectorIt == cache.end()) {
+		return nullptr;
+	}
+
+	auto it = sectorIt->second.find(centerPos);
+	if (it == sectorIt->second.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+void Map::clearSpectatorCache(const Position& pos, bool isPlayer)
 {
-	spectatorCache.clear();
+	clearSectorCache(spectatorCache, pos);
+	if (isPlayer) {
+		clearSectorCache(playersSpectatorCache, pos);
+	}
 }
 
-void Map::clearPlayersSpectatorCache()
+void Map::clearSectorCache(SectorSpectatorCache& cache, const Position& pos)
 {
-	playersSpectatorCache.clear();
+	if (cache.empty()) {
+		return;
+	}
+
+	int32_t minSectorX = std::max<int32_t>(0, pos.x - spectatorCacheRangeX) >> FLOOR_BITS;
+	int32_t maxSectorX = (pos.x + spectatorCacheRangeX) >> FLOOR_BITS;
+	int32_t minSectorY = std::max<int32_t>(0, pos.y - spectatorCacheRangeY) >> FLOOR_BITS;
+	int32_t maxSectorY = (pos.y + spectatorCacheRangeY) >> FLOOR_BITS;
+
+	// walk whichever is smaller, the cached sectors or the sectors in range
+	size_t sectorsInRange = (maxSectorX - minSectorX + 1) * (maxSectorY - minSectorY + 1);
+	if (cache.size() < sectorsInRange) {
+		for (auto it = cache.begin(); it != cache.end(); ) {
+			int32_t sectorX = it->first >> 16;
+			int32_t sectorY = it->first & 0xFFFF;
+			if (sectorX >= minSectorX && sectorX <= maxSectorX && sectorY >= minSectorY && sectorY <= maxSectorY) {
+				it = cache.erase(it);
+			} else {
+				++it;
+			}
+		}
+		return;
+	}
+
+	for (int32_t sectorY = minSectorY; sectorY <= maxSectorY; ++sectorY) {
+		for (int32_t sectorX = minSectorX; sectorX <= maxSectorX; ++sectorX) {
+			cache.erase(getSectorKey(sectorX, sectorY));
+		}
+	}
 }
 
 bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool multiFloor) const
@@ -543,6 +646,28 @@ bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool
 		return false;
 	}
 
+	// the line walks read the floor bitmaps instead of the tiles and their item lists,
+	// consecutive tests mostly stay in one sector so the last floor is kept around
+	int32_t cachedSectorX = -1;
+	int32_t cachedSectorY = -1;
+	int32_t cachedZ = -1;
+	const Floor* cachedFloor = nullptr;
+	auto testTile = [&](int32_t x, int32_t y, int32_t z, uint64_t Floor::* bitmap) {
+		if (z < 0 || z >= MAP_MAX_LAYERS) {
+			return false;
+		}
+
+		if ((x >> FLOOR_BITS) != cachedSectorX || (y >> FLOOR_BITS) != cachedSectorY || z != cachedZ) {
+			cachedSectorX = x >> FLOOR_BITS;
+			cachedSectorY = y >> FLOOR_BITS;
+			cachedZ = z;
+
+			const QTreeLeafNode* leaf = sectors.get(x, y);
+			cachedFloor = leaf ? leaf->getFloor(z) : nullptr;
+		}
+		return cachedFloor && (((*cachedFloor).*bitmap >> ((x & FLOOR_MASK) * FLOOR_SIZE + (y & FLOOR_MASK))) & 1);
+	};
+
 	int32_t sx = fromPos.x;
 	int32_t sy = fromPos.y;
 	int32_t sz = fromPos.z;
@@ -558,8 +683,7 @@ bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool
 
 	if (sz_minus_one >= sz_minus_power) {
 		while (true) {
-			const Tile* tile = getTile(sx, sy, sz_minus_one);
-			if (tile && tile->getGround()) {
+			if (testTile(sx, sy, sz_minus_one, &Floor::groundTiles)) {
 				break;
 			}
 
@@ -621,10 +745,9 @@ bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool
 
 					do
 					{
-						const Tile* tile = getTile((x_check + (delta - i) * sx) / delta,
+						if (testTile((x_check + (delta - i) * sx) / delta,
 							(y_check + (delta - i) * sy) / delta,
-							sz_minus_power_copy);
-						if (tile && tile->hasProperty(CONST_PROP_BLOCKPROJECTILE)) {
+							sz_minus_power_copy, &Floor::sightBlockedTiles)) {
 							break;
 						}
 
@@ -649,8 +772,7 @@ bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool
 
 				if (sz_minus_power_copy < to_zz_copy) {
 					while (true) {
-						const Tile* tile = getTile(x_final_test, y_final_test, i);
-						if (tile && tile->getGround()) {
+						if (testTile(x_final_test, y_final_test, i, &Floor::groundTiles)) {
 							break;
 						}
 
@@ -680,10 +802,72 @@ bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool
 	return false;
 }
 
+void Map::updateWalkability(const Tile* tile)
+{
+	const Position& pos = tile->getPosition();
+	const QTreeLeafNode* leaf = sectors.get(pos.x, pos.y);
+	if (!leaf) {
+		return;
+	}
+
+	Floor* floor = leaf->getFloor(pos.z);
+	if (!floor) {
+		return;
+	}
+
+	const uint32_t offsetX = pos.x & FLOOR_MASK;
+	const uint32_t offsetY = pos.y & FLOOR_MASK;
+	if (floor->tiles[offsetX][offsetY] != tile) {
+		// still being built by the map loader, setTile fills the bits in
+		return;
+	}
+
+	const uint64_t bit = uint64_t(1) << (offsetX * FLOOR_SIZE + offsetY);
+	const bool blocked = !tile->getGround() || tile->hasFlag(TILESTATE_PATHFINDING_BLOCKED);
+	const bool monsterBlocked = blocked || tile->hasFlag(TILESTATE_MONSTER_BLOCKED);
+
+	floor->blockedTiles = blocked ? (floor->blockedTiles | bit) : (floor->blockedTiles & ~bit);
+	floor->monsterBlockedTiles = monsterBlocked ? (floor->monsterBlockedTiles | bit) : (floor->monsterBlockedTiles & ~bit);
+	// the tile flag only covers the items above the ground
+	const Item* ground = tile->getGround();
+	const bool sightBlocked = tile->hasFlag(TILESTATE_BLOCKPROJECTILE) || (ground && ground->hasProperty(CONST_PROP_BLOCKPROJECTILE));
+
+	floor->groundTiles = ground ? (floor->groundTiles | bit) : (floor->groundTiles & ~bit);
+	floor->sightBlockedTiles = sightBlocked ? (floor->sightBlockedTiles | bit) : (floor->sightBlockedTiles & ~bit);
+}
+
 const Tile* Map::canWalkTo(const Creature& creature, const Position& pos) const
 {
-	Tile* tile = getTile(pos.x, pos.y, pos.z);
+	if (pos.z >= MAP_MAX_LAYERS) {
+		return nullptr;
+	}
+
+	const QTreeLeafNode* leaf = sectors.get(pos.x, pos.y);
+	if (!leaf) {
+		return nullptr;
+	}
+
+	const Floor* floor = leaf->getFloor(pos.z);
+	if (!floor) {
+		return nullptr;
+	}
+
+	const uint32_t offsetX = pos.x & FLOOR_MASK;
+	const uint32_t offsetY = pos.y & FLOOR_MASK;
+	Tile* tile = floor->tiles[offsetX][offsetY];
 	if (creature.getTile() != tile) {
+		// static blockers are a bit test, only the creature dependent checks query the tile
+		const uint64_t blockedTiles = creature.getMonster() ? floor->monsterBlockedTiles : floor->blockedTiles;
+		if (blockedTiles & (uint64_t(1) << (offsetX * FLOOR_SIZE + offsetY))) {
+#ifdef STATS_ENABLED
+			walkabilityBitmapHits.fetch_add(1, std::memory_order_relaxed);
+#endif
+			return nullptr;
+		}
+#ifdef STATS_ENABLED
+		walkabilityBitmapMisses.fetch_add(1, std::memory_order_relaxed);
+#endif
+
 		uint32_t flags = FLAG_PATHFINDING;
 		if (const Monster* monster = creature.getMonster()) {
 			if (monster->isIgnoringFieldDamage()) {
@@ -880,21 +1064,198 @@ bool Map::getPathMatching(Creature& creature, std::vector<Direction>& dirList, c
 	return true;
 }
 
+bool Map::isMonsterWalkBlocked(uint16_t x, uint16_t y, uint8_t z) const
+{
+	const QTreeLeafNode* leaf = sectors.get(x, y);
+	if (!leaf) {
+		return true;
+	}
+
+	const Floor* floor = leaf->getFloor(z);
+	if (!floor) {
+		return true;
+	}
+	return (floor->monsterBlockedTiles >> ((x & FLOOR_MASK) * FLOOR_SIZE + (y & FLOOR_MASK))) & 1;
+}
+
+const Map::FlowField& Map::getFlowField(const Creature& target)
+{
+	const Position& targetPos = target.getPosition();
+	const int64_t now = OTSYS_TIME();
+
+	auto it = flowFields.find(target.getID());
+	if (it != flowFields.end()) {
+		const FlowField& field = *it->second;
+		if (field.center == targetPos && now - field.createdAt < flowFieldLifetime) {
+			return field;
+		}
+	} else {
+		if (flowFields.size() >= maxFlowFields) {
+			for (auto fieldIt = flowFields.begin(); fieldIt != flowFields.end();) {
+				if (now - fieldIt->second->createdAt >= flowFieldLifetime) {
+					fieldIt = flowFields.erase(fieldIt);
+				} else {
+					++fieldIt;
+				}
+			}
+		}
+		it = flowFields.emplace(target.getID(), new FlowField()).first;
+	}
+
+#ifdef STATS_ENABLED
+	AutoStat stat("Map::getFlowField");
+#endif
+
+	FlowField& field = *it->second;
+	field.center = targetPos;
+	field.createdAt = now;
+	std::fill(std::begin(field.cost), std::end(field.cost), flowFieldUnreachable);
+
+	// Dijkstra outwards from the tiles next to the target with the A* step costs
+	using QueueEntry = std::pair<uint16_t, uint16_t>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+	const int32_t originX = targetPos.x - flowFieldRadius;
+	const int32_t originY = targetPos.y - flowFieldRadius;
+	for (int32_t dy = -1; dy <= 1; ++dy) {
+		for (int32_t dx = -1; dx <= 1; ++dx) {
+			if (dx == 0 && dy == 0) {
+				continue;
+			}
+
+			const Position goalPos(targetPos.x + dx, targetPos.y + dy, targetPos.z);
+			if (isMonsterWalkBlocked(goalPos.x, goalPos.y, goalPos.z) || !g_game.canThrowObjectTo(goalPos, targetPos, false)) {
+				continue;
+			}
+
+			const uint16_t index = (flowFieldRadius + dy) * flowFieldSize + (flowFieldRadius + dx);
+			field.cost[index] = 0;
+			queue.emplace(0, index);
+		}
+	}
+
+	while (!queue.empty()) {
+		const auto [cost, index] = queue.top();
+		queue.pop();
+		if (cost != field.cost[index]) {
+			continue;
+		}
+
+		const int32_t cellX = index % flowFieldSize;
+		const int32_t cellY = index / flowFieldSize;
+		for (int32_t dy = -1; dy <= 1; ++dy) {
+			for (int32_t dx = -1; dx <= 1; ++dx) {
+				const int32_t nextX = cellX + dx;
+				const int32_t nextY = cellY + dy;
+				if ((dx == 0 && dy == 0) || nextX < 0 || nextY < 0 || nextX >= flowFieldSize || nextY >= flowFieldSize) {
+					continue;
+				}
+
+				const uint16_t nextIndex = nextY * flowFieldSize + nextX;
+				const uint16_t nextCost = cost + (dx != 0 && dy != 0 ? MAP_DIAGONALWALKCOST : MAP_NORMALWALKCOST);
+				if (nextCost >= field.cost[nextIndex] || isMonsterWalkBlocked(originX + nextX, originY + nextY, targetPos.z)) {
+					continue;
+				}
+
+				field.cost[nextIndex] = nextCost;
+				queue.emplace(nextCost, nextIndex);
+			}
+		}
+	}
+	return field;
+}
+
+bool Map::getFlowFieldPath(Creature& creature, const Creature& target, std::vector<Direction>& dirList, int32_t maxSearchDist)
+{
+	const Position& startPos = creature.getPosition();
+	const Position& targetPos = target.getPosition();
+	if (startPos.z != targetPos.z || Position::areInRange<1, 1>(startPos, targetPos) ||
+		!Position::areInRange<flowFieldRadius, flowFieldRadius>(startPos, targetPos)) {
+		return false;
+	}
+
+	const FlowField& field = getFlowField(target);
+
+	static constexpr int_fast32_t neighbors[8][2] = {
+		{-1, 0}, {0, 1}, {1, 0}, {0, -1}, {-1, -1}, {1, -1}, {1, 1}, {-1, 1}
+	};
+	static constexpr Direction directions[8] = {
+		DIRECTION_WEST, DIRECTION_SOUTH, DIRECTION_EAST, DIRECTION_NORTH,
+		DIRECTION_NORTHWEST, DIRECTION_NORTHEAST, DIRECTION_SOUTHEAST, DIRECTION_SOUTHWEST
+	};
+
+	const int32_t originX = targetPos.x - flowFieldRadius;
+	const int32_t originY = targetPos.y - flowFieldRadius;
+
+	Position pos = startPos;
+	uint16_t cost = field.cost[(pos.y - originY) * flowFieldSize + (pos.x - originX)];
+	if (cost == flowFieldUnreachable) {
+		return false;
+	}
+
+	// walk down the field, every step still has to pass this creature's own walk checks;
+	// tiles A* charges extra for (creatures it may not pass, fields it is not immune to) leave it to A*
+	while (cost != 0) {
+		int32_t bestStep = -1;
+		uint32_t bestCost = flowFieldUnreachable;
+		for (int32_t i = 0; i < 8; ++i) {
+			const int32_t cellX = pos.x + neighbors[i][0] - originX;
+			const int32_t cellY = pos.y + neighbors[i][1] - originY;
+			if (cellX < 0 || cellY < 0 || cellX >= flowFieldSize || cellY >= flowFieldSize) {
+				continue;
+			}
+
+			const uint16_t nextCost = field.cost[cellY * flowFieldSize + cellX];
+			if (nextCost == flowFieldUnreachable) {
+				continue;
+			}
+
+			const uint32_t stepCost = nextCost + (i >= 4 ? MAP_DIAGONALWALKCOST : MAP_NORMALWALKCOST);
+			if (stepCost < bestCost) {
+				bestCost = stepCost;
+				bestStep = i;
+			}
+		}
+
+		if (bestStep == -1) {
+			return false;
+		}
+
+		pos.x += neighbors[bestStep][0];
+		pos.y += neighbors[bestStep][1];
+		if (maxSearchDist != 0 && (Position::getDistanceX(startPos, pos) > maxSearchDist || Position::getDistanceY(startPos, pos) > maxSearchDist)) {
+			return false;
+		}
+
+		const Tile* tile = canWalkTo(creature, pos);
+		if (!tile || AStarNodes::getTileWalkCost(creature, tile) != 0) {
+			return false;
+		}
+
+		dirList.push_back(directions[bestStep]);
+		cost = field.cost[(pos.y - originY) * flowFieldSize + (pos.x - originX)];
+	}
+	return true;
+}
+
 // AStarNodes
 
 AStarNodes::AStarNodes(uint32_t x, uint32_t y)
-	: nodes(), openNodes()
+	: grid(), startX(x), startY(y)
 {
 	curNode = 1;
 	closedNodes = 0;
-	openNodes[0] = true;
 
 	AStarNode& startNode = nodes[0];
 	startNode.parent = nullptr;
 	startNode.x = x;
 	startNode.y = y;
 	startNode.f = 0;
-	nodeTable[(x << 16) | y] = nodes;
+	grid[GRID_RADIUS * GRID_SIZE + GRID_RADIUS] = 1;
+
+	openHeap[0] = 0;
+	heapPosition[0] = 0;
+	openCount = 1;
 }
 
 AStarNode* AStarNodes::createOpenNode(AStarNode* parent, uint32_t x, uint32_t y, int_fast32_t f)
@@ -904,54 +1265,72 @@ AStarNode* AStarNodes::createOpenNode(AStarNode* parent, uint32_t x, uint32_t y,
 	}
 
 	size_t retNode = curNode++;
-	openNodes[retNode] = true;
 
 	AStarNode* node = nodes + retNode;
-	nodeTable[(x << 16) | y] = node;
 	node->parent = parent;
 	node->x = x;
 	node->y = y;
 	node->f = f;
+
+	const uint32_t gridX = x - startX + GRID_RADIUS;
+	const uint32_t gridY = y - startY + GRID_RADIUS;
+	if (gridX < GRID_SIZE && gridY < GRID_SIZE) {
+		grid[gridY * GRID_SIZE + gridX] = retNode + 1;
+	} else {
+		farNodes[farNodeCount++] = retNode;
+	}
+
+	heapPosition[retNode] = openCount;
+	openHeap[openCount++] = retNode;
+	siftUp(openCount - 1);
 	return node;
 }
 
 AStarNode* AStarNodes::getBestNode()
 {
-	if (curNode == 0) {
+	if (openCount == 0) {
 		return nullptr;
 	}
-
-	int32_t best_node_f = std::numeric_limits<int32_t>::max();
-	int32_t best_node = -1;
-	for (size_t i = 0; i < curNode; i++) {
-		if (openNodes[i] && nodes[i].f < best_node_f) {
-			best_node_f = nodes[i].f;
-			best_node = i;
-		}
-	}
-
-	if (best_node >= 0) {
-		return nodes + best_node;
-	}
-	return nullptr;
+	return nodes + openHeap[0];
 }
 
 void AStarNodes::closeNode(AStarNode* node)
 {
 	size_t index = node - nodes;
 	assert(index < MAX_NODES);
-	openNodes[index] = false;
+
+	const size_t position = heapPosition[index];
+	if (position == NOT_OPEN) {
+		return;
+	}
+
+	heapPosition[index] = NOT_OPEN;
 	++closedNodes;
+
+	if (--openCount == position) {
+		return;
+	}
+
+	openHeap[position] = openHeap[openCount];
+	heapPosition[openHeap[position]] = position;
+	siftDown(position);
+	siftUp(position);
 }
 
 void AStarNodes::openNode(AStarNode* node)
 {
 	size_t index = node - nodes;
 	assert(index < MAX_NODES);
-	if (!openNodes[index]) {
-		openNodes[index] = true;
+
+	// the node f only ever decreases here, moving it up is enough
+	size_t position = heapPosition[index];
+	if (position == NOT_OPEN) {
+		position = openCount++;
+		heapPosition[index] = position;
+		openHeap[position] = index;
 		--closedNodes;
 	}
+	siftUp(position);
 }
 
 int_fast32_t AStarNodes::getClosedNodes() const
@@ -961,11 +1340,76 @@ int_fast32_t AStarNodes::getClosedNodes() const
 
 AStarNode* AStarNodes::getNodeByPosition(uint32_t x, uint32_t y)
 {
-	auto it = nodeTable.find((x << 16) | y);
-	if (it == nodeTable.end()) {
-		return nullptr;
+	const uint32_t gridX = x - startX + GRID_RADIUS;
+	const uint32_t gridY = y - startY + GRID_RADIUS;
+	if (gridX < GRID_SIZE && gridY < GRID_SIZE) {
+		const uint16_t index = grid[gridY * GRID_SIZE + gridX];
+		if (index == 0) {
+			return nullptr;
+		}
+		return nodes + (index - 1);
+	}
+
+	for (size_t i = 0; i < farNodeCount; ++i) {
+		AStarNode* node = nodes + farNodes[i];
+		if (node->x == x && node->y == y) {
+			return node;
+		}
+	}
+	return nullptr;
+}
+
+bool AStarNodes::isBetterNode(uint16_t lhs, uint16_t rhs) const
+{
+	// same order the old linear scan picked: lowest f first, then the node created first
+	if (nodes[lhs].f != nodes[rhs].f) {
+		return nodes[lhs].f < nodes[rhs].f;
+	}
+	return lhs < rhs;
+}
+
+void AStarNodes::siftUp(size_t position)
+{
+	const uint16_t index = openHeap[position];
+	while (position > 0) {
+		const size_t parent = (position - 1) / 2;
+		if (!isBetterNode(index, openHeap[parent])) {
+			break;
+		}
+
+		openHeap[position] = openHeap[parent];
+		heapPosition[openHeap[position]] = position;
+		position = parent;
 	}
-	return it->second;
+
+	openHeap[position] = index;
+	heapPosition[index] = position;
+}
+
+void AStarNodes::siftDown(size_t position)
+{
+	const uint16_t index = openHeap[position];
+	while (true) {
+		size_t child = position * 2 + 1;
+		if (child >= openCount) {
+			break;
+		}
+
+		if (child + 1 < openCount && isBetterNode(openHeap[child + 1], openHeap[child])) {
+			++child;
+		}
+
+		if (!isBetterNode(openHeap[child], index)) {
+			break;
+		}
+
+		openHeap[position] = openHeap[child];
+		heapPosition[openHeap[position]] = position;
+		position = child;
+	}
+
+	openHeap[position] = index;
+	heapPosition[index] = position;
 }
 
 int_fast32_t AStarNodes::getMapWalkCost(AStarNode* node, const Position& neighborPos)
@@ -1023,19 +1467,6 @@ QTreeNode::~QTreeNode()
 	}
 }
 
-QTreeLeafNode* QTreeNode::getLeaf(uint32_t x, uint32_t y)
-{
-	if (leaf) {
-		return static_cast<QTreeLeafNode*>(this);
-	}
-
-	QTreeNode* node = child[((x & 0x8000) >> 15) | ((y & 0x8000) >> 14)];
-	if (!node) {
-		return nullptr;
-	}
-	return node->getLeaf(x << 1, y << 1);
-}
-
 QTreeLeafNode* QTreeNode::createLeaf(uint32_t x, uint32_t y, uint32_t level)
 {
 	if (!isLeaf()) {
@@ -1073,28 +1504,69 @@ Floor* QTreeLeafNode::createFloor(uint32_t z)
 
 void QTreeLeafNode::addCreature(Creature* c)
 {
-	creature_list.push_back(c);
+	creature_list.add(c);
 
 	if (c->getPlayer()) {
-		player_list.push_back(c);
+		player_list.add(c);
 	}
 }
 
 void QTreeLeafNode::removeCreature(Creature* c)
 {
-	auto iter = std::find(creature_list.begin(), creature_list.end(), c);
-	assert(iter != creature_list.end());
-	*iter = creature_list.back();
-	creature_list.pop_back();
+	creature_list.remove(c);
 
 	if (c->getPlayer()) {
-		iter = std::find(player_list.begin(), player_list.end(), c);
-		assert(iter != player_list.end());
-		*iter = player_list.back();
-		player_list.pop_back();
+		player_list.remove(c);
 	}
 }
 
+void QTreeLeafNode::updateCreature(Creature* c)
+{
+	creature_list.update(c);
+
+	if (c->getPlayer()) {
+		player_list.update(c);
+	}
+}
+
+void SectorCreatureList::add(Creature* c)
+{
+	const Position& pos = c->getPosition();
+	creatures.push_back(c);
+	x.push_back(pos.x);
+	y.push_back(pos.y);
+	z.push_back(pos.z);
+}
+
+void SectorCreatureList::remove(Creature* c)
+{
+	auto iter = std::find(creatures.begin(), creatures.end(), c);
+	assert(iter != creatures.end());
+
+	size_t index = std::distance(creatures.begin(), iter);
+	creatures[index] = creatures.back();
+	x[index] = x.back();
+	y[index] = y.back();
+	z[index] = z.back();
+
+	creatures.pop_back();
+	x.pop_back();
+	y.pop_back();
+	z.pop_back();
+}
+
+void SectorCreatureList::update(Creature* c)
+{
+	auto iter = std::find(creatures.begin(), creatures.end(), c);
+	assert(iter != creatures.end());
+
+	const Position& pos = c->getPosition();
+	size_t index = std::distance(creatures.begin(), iter);
+	x[index] = pos.x;
+	y[index] = pos.y;
+	z[index] = pos.z;
+}
+
 uint32_t Map::refreshMap() const
 {
 	uint64_t start = OTSYS_TIME();
@@ -66,14 +66,34 @@ class AStarNodes
 		static int_fast32_t getTileWalkCost(Creature& creature, const Tile* tile);
 
 	private:
+		// nodes within GRID_RADIUS of the start position are found through a flat grid,
+		// the few that wander farther away are kept in a short list that is scanned
+		static constexpr int32_t GRID_RADIUS = 32;
+		static constexpr int32_t GRID_SIZE = GRID_RADIUS * 2;
+		static constexpr uint16_t NOT_OPEN = std::numeric_limits<uint16_t>::max();
+
+		bool isBetterNode(uint16_t lhs, uint16_t rhs) const;
+		void siftUp(size_t position);
+		void siftDown(size_t position);
+
 		AStarNode nodes[MAX_NODES];
-		bool openNodes[MAX_NODES];
-		std::unordered_map<uint32_t, AStarNode*> nodeTable;
+		// binary heap of open node indexes ordered by f, ties go to the older node
+		uint16_t openHeap[MAX_NODES];
+		uint16_t heapPosition[MAX_NODES];
+		// node index + 1 for every grid cell, 0 when the cell has no node
+		uint16_t grid[GRID_SIZE * GRID_SIZE];
+		uint16_t farNodes[MAX_NODES];
+		size_t openCount = 0;
+		size_t farNodeCount = 0;
+		uint32_t startX;
+		uint32_t startY;
 		size_t curNode;
 		int_fast32_t closedNodes;
 };
 
 using SpectatorCache = std::map<Position, SpectatorVec>;
+// spectator lists grouped by the FLOOR_SIZE x FLOOR_SIZE sector holding their center position
+using SectorSpectatorCache = std::unordered_map<uint32_t, SpectatorCache>;
 
 static constexpr int32_t FLOOR_BITS = 3;
 static constexpr int32_t FLOOR_SIZE = (1 << FLOOR_BITS);
@@ -88,11 +108,41 @@ struct Floor {
 	Floor& operator=(const Floor&) = delete;
 
 	Tile* tiles[FLOOR_SIZE][FLOOR_SIZE] = {};
+
+	// one bit per tile (x * FLOOR_SIZE + y) set when pathfinding can never enter it,
+	// for any creature and for monsters; empty slots count as blocked
+	uint64_t blockedTiles = ~uint64_t(0);
+	uint64_t monsterBlockedTiles = ~uint64_t(0);
+
+	// same layout for the line of sight checks, empty slots have no ground and block nothing
+	uint64_t groundTiles = 0;
+	uint64_t sightBlockedTiles = 0;
 };
 
+static_assert(FLOOR_SIZE * FLOOR_SIZE <= 64, "Floor walkability bitmaps hold one bit per tile");
+
 class FrozenPathingConditionCall;
 class QTreeLeafNode;
 
+// Creatures of one leaf (an 8x8 sector) with their coordinates mirrored in
+// parallel arrays, so spectator range checks scan packed integers instead of
+// dereferencing every creature.
+struct SectorCreatureList
+{
+	void add(Creature* c);
+	void remove(Creature* c);
+	void update(Creature* c);
+
+	size_t size() const {
+		return creatures.size();
+	}
+
+	CreatureVector creatures;
+	std::vector<uint16_t> x;
+	std::vector<uint16_t> y;
+	std::vector<uint8_t> z;
+};
+
 class QTreeNode
 {
 	public:
@@ -107,23 +157,6 @@ class QTreeNode
 			return leaf;
 		}
 
-		QTreeLeafNode* getLeaf(uint32_t x, uint32_t y);
-
-		template<typename Leaf, typename Node>
-		static Leaf getLeafStatic(Node node, uint32_t x, uint32_t y)
-		{
-			do {
-				node = node->child[((x & 0x8000) >> 15) | ((y & 0x8000) >> 14)];
-				if (!node) {
-					return nullptr;
-				}
-
-				x <<= 1;
-				y <<= 1;
-			} while (!node->leaf);
-			return static_cast<Leaf>(node);
-		}
-
 		QTreeLeafNode* createLeaf(uint32_t x, uint32_t y, uint32_t level);
 
 	protected:
@@ -152,19 +185,65 @@ class QTreeLeafNode final : public QTreeNode
 
 		void addCreature(Creature* c);
 		void removeCreature(Creature* c);
+		void updateCreature(Creature* c);
 
 	private:
 		static bool newLeaf;
 		QTreeLeafNode* leafS = nullptr;
 		QTreeLeafNode* leafE = nullptr;
 		Floor* array[MAP_MAX_LAYERS] = {};
-		CreatureVector creature_list;
-		CreatureVector player_list;
+		SectorCreatureList creature_list;
+		SectorCreatureList player_list;
 
 		friend class Map;
 		friend class QTreeNode;
 };
 
+// Flat directory of quadtree leaves: 128x128 blocks of 64x64 sectors, a
+// block is allocated when the first leaf inside it is created. Resolving a
+// leaf costs two dependent loads instead of a walk down the quadtree.
+class SectorTable
+{
+	public:
+		static constexpr uint32_t BLOCK_BITS = 6;
+		static constexpr uint32_t BLOCK_SIZE = (1 << BLOCK_BITS);
+		static constexpr uint32_t BLOCK_MASK = (BLOCK_SIZE - 1);
+		static constexpr uint32_t DIRECTORY_BITS = 16 - FLOOR_BITS - BLOCK_BITS;
+		static constexpr uint32_t DIRECTORY_SIZE = (1 << DIRECTORY_BITS);
+
+		QTreeLeafNode* get(uint32_t x, uint32_t y) const {
+			if (x > 0xFFFF || y > 0xFFFF) {
+				return nullptr;
+			}
+
+			const Block* block = blocks[getBlockIndex(x, y)].get();
+			if (!block) {
+				return nullptr;
+			}
+			return (*block)[getSectorIndex(x, y)];
+		}
+
+		void set(uint32_t x, uint32_t y, QTreeLeafNode* leaf) {
+			std::unique_ptr<Block>& block = blocks[getBlockIndex(x, y)];
+			if (!block) {
+				block.reset(new Block());
+			}
+			(*block)[getSectorIndex(x, y)] = leaf;
+		}
+
+	private:
+		using Block = std::array<QTreeLeafNode*, BLOCK_SIZE * BLOCK_SIZE>;
+
+		static uint32_t getBlockIndex(uint32_t x, uint32_t y) {
+			return ((x >> (FLOOR_BITS + BLOCK_BITS)) << DIRECTORY_BITS) | (y >> (FLOOR_BITS + BLOCK_BITS));
+		}
+		static uint32_t getSectorIndex(uint32_t x, uint32_t y) {
+			return (((x >> FLOOR_BITS) & BLOCK_MASK) << BLOCK_BITS) | ((y >> FLOOR_BITS) & BLOCK_MASK);
+		}
+
+		std::array<std::unique_ptr<Block>, DIRECTORY_SIZE * DIRECTORY_SIZE> blocks;
+};
+
 struct SpawnMatrix
 {
 	~SpawnMatrix() {
@@ -257,8 +336,20 @@ class Map
 		                   int32_t minRangeX = 0, int32_t maxRangeX = 0,
 		                   int32_t minRangeY = 0, int32_t maxRangeY = 0);
 
-		void clearSpectatorCache();
-		void clearPlayersSpectatorCache();
+		// drops the cached spectator lists whose viewport covers pos
+		void clearSpectatorCache(const Position& pos, bool isPlayer);
+
+		std::atomic<uint64_t> spectatorCacheHits{0};
+		std::atomic<uint64_t> spectatorCacheMisses{0};
+
+		// refreshes the walkability and sight bits of a tile placed on the map after its flags or ground changed
+		void updateWalkability(const Tile* tile);
+
+#ifdef STATS_ENABLED
+		// walk checks answered by the floor bitmaps alone, and the ones that had to query the tile
+		mutable std::atomic<uint64_t> walkabilityBitmapHits{0};
+		mutable std::atomic<uint64_t> walkabilityBitmapMisses{0};
+#endif
 
 		/**
 		  * Checks if you can throw an object to that position
@@ -276,10 +367,14 @@ class Map
 		bool getPathMatching(Creature& creature, std::vector<Direction>& dirList,
 		                     const FrozenPathingConditionCall& pathCondition, const FindPathParams& fpp) const;
 
+		// Path next to target following the distance field shared by every monster chasing it.
+		// Returns false whenever the shared route does not fit this creature, callers fall back to getPathTo.
+		bool getFlowFieldPath(Creature& creature, const Creature& target, std::vector<Direction>& dirList, int32_t maxSearchDist);
+
 		std::map<std::string, Position> waypoints;
 
 		QTreeLeafNode* getQTNode(uint16_t x, uint16_t y) {
-			return QTreeNode::getLeafStatic<QTreeLeafNode*, QTreeNode*>(&root, x, y);
+			return sectors.get(x, y);
 		}
 
 		Spawns spawns;
@@ -287,10 +382,41 @@ class Map
 		Houses houses;
 
 	private:
-		SpectatorCache spectatorCache;
-		SpectatorCache playersSpectatorCache;
+		// a multi-floor viewport is shifted one tile per floor of difference, at most 7 floors
+		static constexpr int32_t spectatorCacheRangeX = maxViewportX + 7;
+		static constexpr int32_t spectatorCacheRangeY = maxViewportY + 7;
+		static constexpr size_t maxSpectatorCacheSectors = 4096;
+
+		static uint32_t getSectorKey(int32_t sectorX, int32_t sectorY) {
+			return (static_cast<uint32_t>(sectorX) << 16) | static_cast<uint32_t>(sectorY);
+		}
+		static const SpectatorVec* findCachedSpectators(const SectorSpectatorCache& cache, const Position& centerPos);
+		static void clearSectorCache(SectorSpectatorCache& cache, const Position& pos);
+
+		SectorSpectatorCache spectatorCache;
+		SectorSpectatorCache playersSpectatorCache;
+
+		// step costs from every tile around a target to the tiles next to it, built from the static
+		// walkability bitmaps; rebuilt when the target moves or after flowFieldLifetime
+		static constexpr int32_t flowFieldRadius = 16;
+		static constexpr int32_t flowFieldSize = flowFieldRadius * 2 + 1;
+		static constexpr int64_t flowFieldLifetime = 1000;
+		static constexpr size_t maxFlowFields = 256;
+		static constexpr uint16_t flowFieldUnreachable = std::numeric_limits<uint16_t>::max();
+
+		struct FlowField {
+			Position center;
+			int64_t createdAt;
+			uint16_t cost[flowFieldSize * flowFieldSize];
+		};
+
+		bool isMonsterWalkBlocked(uint16_t x, uint16_t y, uint8_t z) const;
+		const FlowField& getFlowField(const Creature& target);
+
+		std::unordered_map<uint32_t, std::unique_ptr<FlowField>> flowFields;
 
 		QTreeNode root;
+		SectorTable sectors;
 
 		std::string spawnfile;
 		std::string housefile;
@@ -977,7 +977,7 @@ void Monster::onIdleStimulus()
 
 	// begin select target
 	std::vector<Direction> tempDirList;
-	if (!isSummon() && attackedCreature && !getPathTo(attackedCreature->getPosition(), tempDirList, 0, 1, true, true, 8)) {
+	if (!isSummon() && attackedCreature && !getPathToTarget(tempDirList, 8)) {
 		attackedCreature = nullptr;
 	}
 
@@ -1262,7 +1262,7 @@ void Monster::onIdleStimulus()
 		if (!isSummon()) {
 			pathBlockCheck = true;
 		}
-		const bool foundPath = getPathTo(targetPos, dirList, 0, 1, true, true, 12);
+		const bool foundPath = getPathToTarget(dirList, 12);
 		pathBlockCheck = false;
 
 		if (foundPath) {
@@ -1546,6 +1546,17 @@ bool Monster::getRandomStep(const Position& creaturePos, Direction& resultDir) c
 	return false;
 }
 
+bool Monster::getPathToTarget(std::vector<Direction>& dirList, int32_t maxSearchDist)
+{
+	// monsters chasing the same creature share its distance field, A* only runs when it does not fit
+	if (g_game.map.getFlowFieldPath(*this, *attackedCreature, dirList, maxSearchDist)) {
+		return true;
+	}
+
+	dirList.clear();
+	return getPathTo(attackedCreature->getPosition(), dirList, 0, 1, true, true, maxSearchDist);
+}
+
 bool Monster::getFlightStep(const Position& targetPos, Direction& resultDir) const
 {
 	const Position& creaturePos = getPosition();
@@ -182,6 +182,7 @@ class Monster final : public Creature
 
 		bool getRandomStep(const Position& creaturePos, Direction& resultDir) const;
 		bool getFlightStep(const Position& targetPos, Direction& resultDir) const;
+		bool getPathToTarget(std::vector<Direction>& dirList, int32_t maxSearchDist);
 		bool isIgnoringFieldDamage() const {
 			return isAttackPanicking;
 		}
@@ -29,11 +29,42 @@
 
 #include "pugicast.h"
 
+#include <fstream>
+
 extern Game g_game;
 extern Spells* g_spells;
 extern Monsters g_monsters;
 extern ConfigManager g_config;
 
+namespace {
+
+// monsters bound to the monster script interface or to spell scripts are always
+// parsed again on reload, since the reload is how edited scripts get picked up
+bool hasScripts(const pugi::xml_node& monsterNode)
+{
+	if (monsterNode.attribute("script")) {
+		return true;
+	}
+
+	for (const char* spellList : {"attacks", "defenses"}) {
+		for (auto spellNode : monsterNode.child(spellList).children()) {
+			if (spellNode.attribute("script")) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// spells taken from the spell registry are not owned by the monster type, a spell reload
+// frees them and only parsing the monster again picks up the new ones
+bool hasRegisteredSpells(const std::vector<spellBlock_t>& spells)
+{
+	return std::any_of(spells.begin(), spells.end(), [](const spellBlock_t& sb) { return sb.spell && !sb.combatSpell; });
+}
+
+}
+
 spellBlock_t::~spellBlock_t()
 {
 	if (combatSpell) {
@@ -850,9 +881,25 @@ MonsterType* Monsters::loadMonster(const std::string& file, const std::string& m
 {
 	MonsterType* mType = nullptr;
 
+	std::ifstream monsterFile(file, std::ios::binary);
+	std::string contents{std::istreambuf_iterator<char>(monsterFile), std::istreambuf_iterator<char>()};
+	std::string contentsHash = transformToSHA1(contents);
+
+	if (reloading) {
+		auto hashIt = monsterFileHashes.find(asLowerCaseString(monsterName));
+		if (hashIt != monsterFileHashes.end() && hashIt->second == contentsHash) {
+			auto it = monsters.find(asLowerCaseString(monsterName));
+			if (it != monsters.end()) {
+				return &it->second;
+			}
+		}
+	}
+
+	monsterFileHashes.erase(asLowerCaseString(monsterName));
+
 	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file(file.c_str());
-	if (!result) {
+	pugi::xml_parse_result result = doc.load_buffer(contents.data(), contents.size());
+	if (!monsterFile.is_open() || !result) {
 		printXMLError("Error - Monsters::loadMonster", file, result);
 		return nullptr;
 	}
@@ -1420,6 +1467,10 @@ MonsterType* Monsters::loadMonster(const std::string& file, const std::string& m
 	mType->info.defenseSpells.shrink_to_fit();
 	mType->info.voiceVector.shrink_to_fit();
 	mType->info.scripts.shrink_to_fit();
+
+	if (!hasScripts(monsterNode) && !hasRegisteredSpells(mType->info.attackSpells) && !hasRegisteredSpells(mType->info.defenseSpells)) {
+		monsterFileHashes[asLowerCaseString(monsterName)] = contentsHash;
+	}
 	return mType;
 }
 
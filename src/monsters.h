@@ -304,6 +304,8 @@ class Monsters
 		bool loadLootItem(const pugi::xml_node& node, LootBlock&);
 
 		std::map<std::string, std::string> unloadedMonsters;
+		// content hash of every monster file whose parse result can be kept across a reload
+		std::map<std::string, std::string> monsterFileHashes;
 
 		bool loaded = false;
 };
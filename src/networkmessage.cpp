@@ -48,6 +48,27 @@ Position NetworkMessage::getPosition()
 	return pos;
 }
 
+std::string NetworkMessageView::getString()
+{
+	uint16_t stringLen = get<uint16_t>();
+	if (!canRead(stringLen)) {
+		return std::string();
+	}
+
+	const char* v = reinterpret_cast<const char*>(data) + position;
+	position += stringLen;
+	return std::string(v, stringLen);
+}
+
+Position NetworkMessageView::getPosition()
+{
+	Position pos;
+	pos.x = get<uint16_t>();
+	pos.y = get<uint16_t>();
+	pos.z = getByte();
+	return pos;
+}
+
 void NetworkMessage::addString(const std::string& value)
 {
 	size_t stringLen = value.length();
@@ -172,4 +193,27 @@ void NetworkMessage::addItemCustomAttributes(const Item* item)
 	else {
 		add<uint16_t>(0);
 	}
-}
\ No newline at end of file
+}
+
+std::atomic<uint64_t> NetworkMessagePool::handedOff{0};
+std::atomic<uint64_t> NetworkMessagePool::allocated{0};
+boost::lockfree::stack<NetworkMessage*, boost::lockfree::capacity<NetworkMessagePool::POOL_CAPACITY>> NetworkMessagePool::pool;
+
+NetworkMessage_ptr NetworkMessagePool::getMessage()
+{
+	NetworkMessage* msg;
+	if (pool.pop(msg)) {
+		msg->reset();
+	} else {
+		msg = new NetworkMessage;
+		++allocated;
+	}
+	return NetworkMessage_ptr(msg, &NetworkMessagePool::release);
+}
+
+void NetworkMessagePool::release(NetworkMessage* msg)
+{
+	if (!pool.bounded_push(msg)) {
+		delete msg;
+	}
+}
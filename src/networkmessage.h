@@ -181,4 +181,73 @@ class NetworkMessage
 		}
 };
 
+using NetworkMessage_ptr = std::shared_ptr<NetworkMessage>;
+
+// Read-only window over the payload of a received message, reads stop at the end of the payload
+class NetworkMessageView
+{
+	public:
+		NetworkMessageView(const uint8_t* data, uint16_t size) : data(data), size(size) {}
+
+		uint8_t getByte() {
+			if (!canRead(1)) {
+				return 0;
+			}
+
+			return data[position++];
+		}
+
+		template<typename T>
+		T get() {
+			if (!canRead(sizeof(T))) {
+				return 0;
+			}
+
+			T v;
+			memcpy(&v, data + position, sizeof(T));
+			position += sizeof(T);
+			return v;
+		}
+
+		std::string getString();
+		Position getPosition();
+
+		const uint8_t* getData() const {
+			return data;
+		}
+		uint16_t getSize() const {
+			return size;
+		}
+		uint16_t getReadPosition() const {
+			return position;
+		}
+
+	private:
+		bool canRead(size_t count) const {
+			return position + count <= size;
+		}
+
+		const uint8_t* data;
+		uint16_t size;
+		uint16_t position = 0;
+};
+
+// Inbound messages are recycled and handed from the network thread to the dispatcher by pointer,
+// so no packet is copied on the way to its parser
+class NetworkMessagePool
+{
+	public:
+		static NetworkMessage_ptr getMessage();
+
+		static std::atomic<uint64_t> handedOff;
+		static std::atomic<uint64_t> allocated;
+
+	private:
+		static void release(NetworkMessage* msg);
+
+		// at most this many idle buffers are kept, busier moments allocate and free the surplus
+		static constexpr size_t POOL_CAPACITY = 256;
+		static boost::lockfree::stack<NetworkMessage*, boost::lockfree::capacity<POOL_CAPACITY>> pool;
+};
+
 #endif // #ifndef __NETWORK_MESSAGE_H__
@@ -30,11 +30,14 @@
 #include "protocolstatus.h"
 #include "databasemanager.h"
 #include "scheduler.h"
+#include "cryptotasks.h"
 #include "databasetasks.h"
+#include "filewritetasks.h"
 #include "script.h"
 #include "battlepass.h"
 #include "logger.h"
 #include <fstream>
+#include <future>
 #include <fmt/format.h>
 #include <boost/algorithm/string.hpp>
 #if __has_include("gitmetadata.h")
@@ -42,6 +45,8 @@
 #endif
 
 DatabaseTasks g_databaseTasks;
+CryptoTasks g_cryptoTasks;
+FileWriteTasks g_fileWriteTasks;
 Dispatcher g_dispatcher;
 Scheduler g_scheduler;
 Stats g_stats;
@@ -67,6 +72,117 @@ void startupErrorMessage(const std::string& errorStr)
 void mainLoader(int argc, char* argv[], ServiceManager* services);
 bool argumentsHandler(const StringVector& args);
 
+namespace {
+
+// Runs the startup stages by dependency order. Stages marked concurrent only
+// parse their own data files into their own registry, so they run on worker
+// threads as soon as their dependencies finished; everything touching the Lua
+// environment or the game state runs on the calling (dispatcher) thread.
+class StartupLoader
+{
+	public:
+		using Loader = std::function<bool(void)>;
+
+		void add(std::string name, std::vector<std::string> dependencies, bool concurrent, std::string errorMessage, Loader loader) {
+			stages.push_back({std::move(name), std::move(dependencies), std::move(errorMessage), std::move(loader), concurrent});
+		}
+
+		bool run() {
+			std::vector<std::future<bool>> running(stages.size());
+			std::vector<bool> started(stages.size(), false);
+			size_t pending = stages.size();
+			bool failed = false;
+
+			while (pending != 0) {
+				size_t local = stages.size();
+				if (!failed) {
+					for (size_t i = 0; i < stages.size(); ++i) {
+						if (started[i] || !isReady(stages[i])) {
+							continue;
+						}
+
+						if (stages[i].concurrent) {
+							std::cout << ">> Loading " << stages[i].name << std::endl;
+							running[i] = std::async(std::launch::async, stages[i].loader);
+							started[i] = true;
+						} else if (local == stages.size()) {
+							local = i;
+						}
+					}
+				}
+
+				if (local != stages.size()) {
+					std::cout << ">> Loading " << stages[local].name << std::endl;
+					started[local] = true;
+					--pending;
+					if (!finish(stages[local], stages[local].loader())) {
+						failed = true;
+					}
+					continue;
+				}
+
+				// nothing left to run here, block on the first worker still busy
+				bool waited = false;
+				for (size_t i = 0; i < stages.size(); ++i) {
+					if (!running[i].valid()) {
+						continue;
+					}
+
+					if (!waited || running[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+						waited = true;
+						--pending;
+						if (!finish(stages[i], running[i].get())) {
+							failed = true;
+						}
+					}
+				}
+
+				if (!waited) {
+					// the remaining stages can never become ready
+					if (!failed) {
+						startupErrorMessage("Unresolved startup dependencies!");
+						failed = true;
+					}
+					break;
+				}
+			}
+			return !failed;
+		}
+
+	private:
+		struct Stage {
+			std::string name;
+			std::vector<std::string> dependencies;
+			std::string errorMessage;
+			Loader loader;
+			bool concurrent;
+		};
+
+		bool isReady(const Stage& stage) const {
+			for (const std::string& dependency : stage.dependencies) {
+				if (finished.find(dependency) == finished.end()) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool finish(const Stage& stage, bool success) {
+			if (!success) {
+				startupErrorMessage(stage.errorMessage);
+				return false;
+			}
+
+			finished.insert(stage.name);
+			return true;
+		}
+
+		std::vector<Stage> stages;
+		std::unordered_set<std::string> finished;
+};
+
+}
+
 [[noreturn]] void badAllocationHandler()
 {
 	// Use functions that only use stack allocation
@@ -104,6 +220,8 @@ int main(int argc, char* argv[])
 		std::cout << ">> No services running. The server is NOT online." << std::endl;
 		g_scheduler.shutdown();
 		g_databaseTasks.shutdown();
+		g_cryptoTasks.shutdown();
+		g_fileWriteTasks.shutdown();
 		g_dispatcher.shutdown();
 #ifdef STATS_ENABLED
 		g_stats.shutdown();
@@ -112,6 +230,8 @@ int main(int argc, char* argv[])
 
 	g_scheduler.join();
 	g_databaseTasks.join();
+	g_cryptoTasks.join();
+	g_fileWriteTasks.join();
 	g_dispatcher.join();
 #ifdef STATS_ENABLED
 	g_stats.join();
@@ -144,6 +264,9 @@ void printServerVersion()
 #else
 	std::cout << "unknown" << std::endl;
 #endif
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+	std::cout << "Networking on io_uring" << std::endl;
+#endif
 #if defined(LUAJIT_VERSION)
 	std::cout << "Linked with " << LUAJIT_VERSION << " for Lua support" << std::endl;
 #else
@@ -170,6 +293,8 @@ void mainLoader(int, char*[], ServiceManager* services)
 	//dispatcher thread
 	g_game.setGameState(GAME_STATE_STARTUP);
 
+	int64_t startupTime = OTSYS_TIME();
+
 	srand(static_cast<unsigned int>(OTSYS_TIME()));
 #ifdef _WIN32
 	SetConsoleTitle(STATUS_SERVER_NAME);
@@ -227,6 +352,12 @@ void mainLoader(int, char*[], ServiceManager* services)
 		return;
 	}
 
+	// without workers logins are decrypted on the network thread
+	int32_t rsaWorkerThreads = g_config.getNumber(ConfigManager::RSA_WORKER_THREADS);
+	if (rsaWorkerThreads > 0) {
+		g_cryptoTasks.start(rsaWorkerThreads);
+	}
+
 	std::cout << ">> Establishing database connection..." << std::flush;
 
 	if (!Database::getInstance().connect()) {
@@ -244,6 +375,7 @@ void mainLoader(int, char*[], ServiceManager* services)
 		return;
 	}
 	g_databaseTasks.start();
+	g_fileWriteTasks.start();
 
 	DatabaseManager::updateDatabase();
 
@@ -251,61 +383,6 @@ void mainLoader(int, char*[], ServiceManager* services)
 		std::cout << "> No tables were optimized." << std::endl;
 	}
 
-	//load vocations
-	std::cout << ">> Loading vocations" << std::endl;
-	if (!g_vocations.loadFromXml()) {
-		startupErrorMessage("Unable to load vocations!");
-		return;
-	}
-
-	// load item data
-	std::cout << ">> Loading items" << std::endl;
-
-	if (!Item::items.loadFromXml()) {
-		startupErrorMessage("Unable to load items (XML)!");
-		return;
-	}
-
-	std::cout << ">> Loading script systems" << std::endl;
-	if (!ScriptingManager::getInstance().loadScriptSystems()) {
-		startupErrorMessage("Failed to load script systems");
-		return;
-	}
-
-	std::cout << ">> Loading lua scripts" << std::endl;
-	if (!g_scripts->loadScripts("scripts", false, false)) {
-		startupErrorMessage("Failed to load lua scripts");
-		return;
-	}
-
-	std::cout << ">> Loading Auras Wings and Shaders" << std::endl;
-	if (!g_game.loadAurasWingsShaders()) {
-		std::cout << "Failed to load auras, wings and shaders.\n\t This will not block server load but Auras Wings and Shaders may not work." << ::std::endl;
-	}
-
-	std::cout << ">> Loading monsters" << std::endl;
-	if (!g_monsters.loadFromXml()) {
-		startupErrorMessage("Unable to load monsters!");
-		return;
-	}
-
-	std::cout << ">> Loading lua monsters" << std::endl;
-	if (!g_scripts->loadScripts("monster", false, false)) {
-		startupErrorMessage("Failed to load lua monsters");
-		return;
-	}
-
-	std::cout << ">> Loading outfits" << std::endl;
-	if (!Outfits::getInstance().loadFromXml()) {
-		startupErrorMessage("Unable to load outfits!");
-		return;
-	}
-
-	if (!BattlePasses::getInstance()->load()) {
-		startupErrorMessage("Unable to load battlepass!");
-		return;
-	}
-
 	std::cout << ">> Checking world type... " << std::flush;
 	std::string worldType = boost::algorithm::to_lower_copy(g_config.getString(ConfigManager::WORLD_TYPE));
 	if (worldType == "pvp") {
@@ -323,9 +400,42 @@ void mainLoader(int, char*[], ServiceManager* services)
 	}
 	std::cout << boost::algorithm::to_upper_copy(worldType) << std::endl;
 
-	std::cout << ">> Loading map" << std::endl;
-	if (!g_game.loadMainMap(g_config.getString(ConfigManager::MAP_NAME))) {
-		startupErrorMessage("Failed to load map");
+	StartupLoader loader;
+	loader.add("vocations", {}, true, "Unable to load vocations!", []() {
+		return g_vocations.loadFromXml();
+	});
+	loader.add("items", {}, true, "Unable to load items (XML)!", []() {
+		return Item::items.loadFromXml();
+	});
+	loader.add("outfits", {}, true, "Unable to load outfits!", []() {
+		return Outfits::getInstance().loadFromXml();
+	});
+	loader.add("battlepass", {"items"}, true, "Unable to load battlepass!", []() {
+		return BattlePasses::getInstance()->load();
+	});
+	loader.add("auras, wings and shaders", {}, true, "", []() {
+		if (!g_game.loadAurasWingsShaders()) {
+			std::cout << "Failed to load auras, wings and shaders.\n\t This will not block server load but Auras Wings and Shaders may not work." << ::std::endl;
+		}
+		return true;
+	});
+	loader.add("script systems", {"vocations", "items"}, false, "Failed to load script systems", []() {
+		return ScriptingManager::getInstance().loadScriptSystems();
+	});
+	loader.add("lua scripts", {"script systems"}, false, "Failed to load lua scripts", []() {
+		return g_scripts->loadScripts("scripts", false, false);
+	});
+	loader.add("monsters", {"lua scripts"}, false, "Unable to load monsters!", []() {
+		return g_monsters.loadFromXml();
+	});
+	loader.add("lua monsters", {"monsters"}, false, "Failed to load lua monsters", []() {
+		return g_scripts->loadScripts("monster", false, false);
+	});
+	loader.add("map", {"lua monsters", "outfits", "battlepass", "auras, wings and shaders"}, false, "Failed to load map", []() {
+		return g_game.loadMainMap(g_config.getString(ConfigManager::MAP_NAME));
+	});
+
+	if (!loader.run()) {
 		return;
 	}
 
@@ -339,7 +449,7 @@ void mainLoader(int, char*[], ServiceManager* services)
 	// OT protocols
 	services->add<ProtocolStatus>(static_cast<uint16_t>(g_config.getNumber(ConfigManager::STATUS_PORT)));
 
-	std::cout << ">> Loaded all modules, server starting up..." << std::endl;
+	std::cout << ">> Loaded all modules in " << (OTSYS_TIME() - startupTime) / (1000.) << " seconds, server starting up..." << std::endl;
 
 #ifndef _WIN32
 	if (getuid() == 0 || geteuid() == 0) {
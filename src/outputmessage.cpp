@@ -21,54 +21,46 @@
 
 #include "outputmessage.h"
 #include "protocol.h"
-#include "scheduler.h"
+#include "configmanager.h"
 
-extern Scheduler g_scheduler;
+extern ConfigManager g_config;
 
-namespace {
-
-const std::chrono::milliseconds OUTPUTMESSAGE_AUTOSEND_DELAY {10};
-
-void sendAll(const std::vector<Protocol_ptr>& bufferedProtocols);
-
-void scheduleSendAll(const std::vector<Protocol_ptr>& bufferedProtocols)
+void OutputMessagePool::addPendingProtocol(Protocol_ptr protocol)
 {
-	g_scheduler.addEvent(createSchedulerTask(OUTPUTMESSAGE_AUTOSEND_DELAY.count(), [&]() { sendAll(bufferedProtocols); }));
+	//dispatcher thread
+	if (pendingProtocols.empty()) {
+		pendingSince = OTSYS_TIME();
+	}
+	pendingProtocols.emplace_back(std::move(protocol));
 }
 
-void sendAll(const std::vector<Protocol_ptr>& bufferedProtocols)
+void OutputMessagePool::removeProtocolFromAutosend(const Protocol_ptr& protocol)
 {
 	//dispatcher thread
-	for (auto& protocol : bufferedProtocols) {
-		auto& msg = protocol->getCurrentBuffer();
-		if (msg) {
-			protocol->send(std::move(msg));
-		}
-	}
-
-	if (!bufferedProtocols.empty()) {
-		scheduleSendAll(bufferedProtocols);
+	auto it = std::find(pendingProtocols.begin(), pendingProtocols.end(), protocol);
+	if (it != pendingProtocols.end()) {
+		std::swap(*it, pendingProtocols.back());
+		pendingProtocols.pop_back();
 	}
 }
 
-}
-
-void OutputMessagePool::addProtocolToAutosend(Protocol_ptr protocol)
+void OutputMessagePool::sendAll()
 {
 	//dispatcher thread
-	if (bufferedProtocols.empty()) {
-		scheduleSendAll(bufferedProtocols);
+	for (auto& protocol : pendingProtocols) {
+		auto& msg = protocol->getCurrentBuffer();
+		if (msg) {
+			protocol->send(std::move(msg));
+		}
 	}
-	bufferedProtocols.emplace_back(protocol);
+	pendingProtocols.clear();
 }
 
-void OutputMessagePool::removeProtocolFromAutosend(const Protocol_ptr& protocol)
+void OutputMessagePool::sendExpired()
 {
 	//dispatcher thread
-	auto it = std::find(bufferedProtocols.begin(), bufferedProtocols.end(), protocol);
-	if (it != bufferedProtocols.end()) {
-		std::swap(*it, bufferedProtocols.back());
-		bufferedProtocols.pop_back();
+	if (!pendingProtocols.empty() && OTSYS_TIME() - pendingSince >= g_config.getNumber(ConfigManager::OUTPUT_COALESCING_WINDOW)) {
+		sendAll();
 	}
 }
 
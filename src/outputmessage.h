@@ -29,6 +29,9 @@ class Protocol;
 class OutputMessage : public NetworkMessage
 {
 	public:
+		// set on the message length of packets carrying a deflate chunk
+		enum { COMPRESSED_FLAG = 0x8000 };
+
 		OutputMessage() = default;
 
 		// non-copyable
@@ -43,6 +46,10 @@ class OutputMessage : public NetworkMessage
 			add_header(info.length);
 		}
 
+		void writeCompressedMessageLength() {
+			add_header(static_cast<MsgSize_t>(info.length | COMPRESSED_FLAG));
+		}
+
 		void addCryptoHeader() {
 			writeMessageLength();
 		}
@@ -61,6 +68,12 @@ class OutputMessage : public NetworkMessage
 			info.position += msgLen;
 		}
 
+		void append(const uint8_t* bytes, MsgSize_t length) {
+			memcpy(buffer + info.position, bytes, length);
+			info.length += length;
+			info.position += length;
+		}
+
 	private:
 		template <typename T>
 		void add_header(T add) {
@@ -88,13 +101,19 @@ class OutputMessagePool
 
 		static OutputMessage_ptr getOutputMessage();
 
-		void addProtocolToAutosend(Protocol_ptr protocol);
+		void addPendingProtocol(Protocol_ptr protocol);
 		void removeProtocolFromAutosend(const Protocol_ptr& protocol);
+
+		// sends the output buffered during the current dispatcher cycle
+		void sendAll();
+		// sends early when the oldest buffered output exceeded the coalescing window
+		void sendExpired();
 	private:
 		OutputMessagePool() = default;
-		//NOTE: A vector is used here because this container is mostly read
-		//and relatively rarely modified (only when a client connects/disconnects)
-		std::vector<Protocol_ptr> bufferedProtocols;
+		//NOTE: Only protocols that wrote output since the last flush are kept here,
+		//idle connections cost nothing per cycle
+		std::vector<Protocol_ptr> pendingProtocols;
+		int64_t pendingSince = 0;
 };
 
 #endif
@@ -43,6 +43,7 @@
 
 class House;
 class NetworkMessage;
+class NetworkMessageView;
 class Weapon;
 class ProtocolGame;
 class ProtocolStatus;
@@ -1048,6 +1049,16 @@ class Player final : public Creature, public Cylinder
 				client->writeToOutputBuffer(message);
 			}
 		}
+		void sendBinaryOpcode(uint8_t opcode, const NetworkMessage& message) {
+			if (client) {
+				client->sendBinaryOpcode(opcode, message);
+			}
+		}
+		void sendBinaryOpcode(uint8_t opcode, const NetworkMessageView& message) {
+			if (client) {
+				client->sendBinaryOpcode(opcode, message);
+			}
+		}
 
 		void updateBattlepass(BattlePassQuests_t id, const std::string& value);
 		void updateBattlepass(BattlePassQuests_t id, uint16_t value);
@@ -21,10 +21,15 @@
 
 #include "protocol.h"
 #include "outputmessage.h"
+#include "configmanager.h"
+#include "cryptotasks.h"
 #include "rsa.h"
 #include "xtea.h"
 
+#include <zlib.h>
+
 extern RSA g_RSA;
+extern ConfigManager g_config;
 
 namespace {
 
@@ -60,10 +65,19 @@ bool XTEA_decrypt(NetworkMessage& msg, const xtea::round_keys& key)
 
 }
 
-void Protocol::onSendMessage(const OutputMessage_ptr& msg) const
+void Protocol::onSendMessage(const OutputMessage_ptr& msg)
 {
 	if (!rawMessages) {
-		msg->writeMessageLength();
+		if (compressionRequested && msg->getLength() >= static_cast<uint32_t>(g_config.getNumber(ConfigManager::PACKET_COMPRESSION_MIN_SIZE))) {
+			if (!compress(*msg)) {
+				// the client inflates a single stream, it can not recover from a lost chunk
+				disconnect();
+				return;
+			}
+			msg->writeCompressedMessageLength();
+		} else {
+			msg->writeMessageLength();
+		}
 
 		if (encryptionEnabled) {
 			XTEA_encrypt(*msg, key);
@@ -72,20 +86,70 @@ void Protocol::onSendMessage(const OutputMessage_ptr& msg) const
 	}
 }
 
-void Protocol::onRecvMessage(NetworkMessage& msg)
+void Protocol::onRecvMessage(const NetworkMessage_ptr& msg)
 {
-	if (encryptionEnabled && !XTEA_decrypt(msg, key)) {
+	if (encryptionEnabled && !XTEA_decrypt(*msg, key)) {
 		return;
 	}
 
 	parsePacket(msg);
 }
 
+void Protocol::ZStreamDeleter::operator()(z_stream_s* stream) const
+{
+	deflateEnd(stream);
+	delete stream;
+}
+
+bool Protocol::compress(OutputMessage& msg)
+{
+	//connection lock is held, packets are compressed in the order they are written
+	if (!compressionStream) {
+		z_stream* stream = new z_stream();
+		int level = std::min<int32_t>(Z_BEST_COMPRESSION, std::max<int32_t>(Z_BEST_SPEED, g_config.getNumber(ConfigManager::PACKET_COMPRESSION_LEVEL)));
+		// raw deflate, the packet length header already frames every chunk
+		if (deflateInit2(stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+			delete stream;
+			return false;
+		}
+		compressionStream.reset(stream);
+	}
+
+	// leaves room for the XTEA padding
+	static thread_local uint8_t buffer[NetworkMessage::MAX_PROTOCOL_BODY_LENGTH - NetworkMessage::XTEA_MULTIPLE];
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	z_stream* stream = compressionStream.get();
+	stream->next_in = msg.getOutputBuffer();
+	stream->avail_in = msg.getLength();
+	stream->next_out = buffer;
+	stream->avail_out = sizeof(buffer);
+
+	// sync flush ends every packet on a byte boundary while keeping the shared dictionary
+	if (deflate(stream, Z_SYNC_FLUSH) != Z_OK || stream->avail_in != 0 || stream->avail_out == 0) {
+		return false;
+	}
+
+	auto compressedSize = static_cast<NetworkMessage::MsgSize_t>(sizeof(buffer) - stream->avail_out);
+
+	compressedPackets++;
+	compressionBytesIn += msg.getLength();
+	compressionBytesOut += compressedSize;
+	compressionTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	memcpy(msg.getOutputBuffer(), buffer, compressedSize);
+	msg.setLength(compressedSize);
+	msg.setBufferPosition(compressedSize);
+	return true;
+}
+
 OutputMessage_ptr Protocol::getOutputBuffer(int32_t size)
 {
 	//dispatcher thread
 	if (!outputBuffer) {
 		outputBuffer = OutputMessagePool::getOutputMessage();
+		OutputMessagePool::getInstance().addPendingProtocol(shared_from_this());
 	} else if ((outputBuffer->getLength() + size) > NetworkMessage::MAX_PROTOCOL_BODY_LENGTH) {
 		send(outputBuffer);
 		outputBuffer = OutputMessagePool::getOutputMessage();
@@ -103,6 +167,28 @@ bool Protocol::RSA_decrypt(NetworkMessage& msg)
 	return msg.getByte() == 0;
 }
 
+void Protocol::RSA_decryptAsync(NetworkMessage& msg, std::function<void(bool)> callback)
+{
+	auto connection = getConnection();
+	if (!connection || !g_cryptoTasks.isRunning()) {
+		callback(RSA_decrypt(msg));
+		return;
+	}
+
+	// msg is the connection's own buffer, it stays untouched while reading is suspended
+	connection->suspendRead();
+	g_cryptoTasks.addTask([connection, &msg, callback = std::move(callback)]() {
+		bool success;
+		{
+#ifdef STATS_ENABLED
+			AutoStat stat("RSA_decrypt");
+#endif
+			success = RSA_decrypt(msg);
+		}
+		connection->resumeRead(std::bind(callback, success));
+	});
+}
+
 uint32_t Protocol::getIP() const
 {
 	if (auto connection = getConnection()) {
@@ -23,6 +23,8 @@
 #include "connection.h"
 #include "xtea.h"
 
+struct z_stream_s;
+
 class Protocol : public std::enable_shared_from_this<Protocol>
 {
 	public:
@@ -33,11 +35,11 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 		Protocol(const Protocol&) = delete;
 		Protocol& operator=(const Protocol&) = delete;
 
-		virtual void parsePacket(NetworkMessage&) {}
-		virtual void parsePacketOnDispatcher(NetworkMessage) {}
+		virtual void parsePacket(const NetworkMessage_ptr&) {}
+		virtual void parsePacketOnDispatcher(const NetworkMessage_ptr&) {}
 
-		virtual void onSendMessage(const OutputMessage_ptr& msg) const;
-		void onRecvMessage(NetworkMessage& msg);
+		virtual void onSendMessage(const OutputMessage_ptr& msg);
+		void onRecvMessage(const NetworkMessage_ptr& msg);
 		virtual void onRecvFirstMessage(NetworkMessage& msg) = 0;
 		virtual void onConnect() {}
 
@@ -51,6 +53,12 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 
 		uint32_t getIP() const;
 
+		// cosmetic packets (effects, animated texts) are skipped while this is set
+		bool isBackpressured() const {
+			auto connection = getConnection();
+			return connection && connection->isBackpressured();
+		}
+
 		//Use this function for autosend messages only
 		OutputMessage_ptr getOutputBuffer(int32_t size);
 
@@ -78,20 +86,43 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 		}
 
 		static bool RSA_decrypt(NetworkMessage& msg);
+		// decrypts on the crypto workers when they run, the connection does not read until callback returned
+		void RSA_decryptAsync(NetworkMessage& msg, std::function<void(bool)> callback);
 
 		void setRawMessages(bool value) {
 			rawMessages = value;
 		}
 
+		// outgoing packets are deflated from the next send on, any thread
+		void enableCompression() {
+			compressionRequested = true;
+		}
+		bool isCompressionEnabled() const {
+			return compressionRequested;
+		}
+
 		virtual void release() {}
 
+		std::atomic<uint64_t> compressedPackets{0};
+		std::atomic<uint64_t> compressionBytesIn{0};
+		std::atomic<uint64_t> compressionBytesOut{0};
+		std::atomic<uint64_t> compressionTime{0}; // nanoseconds
+
 	private:
 		friend class Connection;
 
+		bool compress(OutputMessage& msg);
+
+		struct ZStreamDeleter {
+			void operator()(z_stream_s* stream) const;
+		};
+
 		OutputMessage_ptr outputBuffer;
 
 		const ConnectionWeak_ptr connection;
+		std::unique_ptr<z_stream_s, ZStreamDeleter> compressionStream;
 		xtea::round_keys key;
+		std::atomic<bool> compressionRequested{false};
 		bool encryptionEnabled = false;
 		bool rawMessages = false;
 };
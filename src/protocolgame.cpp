@@ -44,6 +44,9 @@ extern Chat* g_chat;
 
 namespace {
 
+// reserved extended opcode used by extended clients to request packet compression
+constexpr uint8_t EXTENDED_OPCODE_COMPRESSION = 0xFF;
+
 using WaitList = std::deque<std::pair<int64_t, uint32_t>>; // (timeout, player guid)
 
 WaitList priorityWaitList, waitList;
@@ -99,6 +102,37 @@ void cleanupList(WaitList& list)
 	}
 }
 
+// Encodes the items of a tile without creatures, which is identical for every viewer
+const std::vector<uint8_t>& getTileItemsDescription(const Tile* tile)
+{
+	if (const std::vector<uint8_t>* cached = tile->getCachedDescription()) {
+		return *cached;
+	}
+
+	static NetworkMessage scratch;
+	scratch.reset();
+
+	int32_t count = 0;
+	if (Item* ground = tile->getGround()) {
+		scratch.addItem(ground);
+		count = 1;
+	}
+
+	if (const TileItemVector* items = tile->getItemList()) {
+		for (auto it = items->getBeginTopItem(), end = items->getEndTopItem(); it != end && count < 10; ++it) {
+			scratch.addItem(*it);
+			count++;
+		}
+
+		for (auto it = items->getBeginDownItem(), end = items->getEndDownItem(); it != end && count < 10; ++it) {
+			scratch.addItem(*it);
+			count++;
+		}
+	}
+
+	return tile->setCachedDescription(scratch.getBuffer() + NetworkMessage::INITIAL_BUFFER_POSITION, scratch.getLength());
+}
+
 std::size_t clientLogin(const Player& player)
 {
 	// Currentslot = position in wait list, 0 for direct access
@@ -149,6 +183,13 @@ void ProtocolGame::release()
 		player = nullptr;
 	}
 
+	if (compressedPackets > 0) {
+		uint64_t bytesIn = compressionBytesIn;
+		g_logger.gameLog(spdlog::level::info, fmt::format("{:s} packet compression: {:d} packets, {:d} -> {:d} bytes ({:.1f}%), {:d} us cpu",
+			convertIPToString(getIP()), compressedPackets.load(), bytesIn, compressionBytesOut.load(),
+			bytesIn > 0 ? (100.0 * compressionBytesOut / bytesIn) : 100.0, compressionTime / 1000), true);
+	}
+
 	OutputMessagePool::getInstance().removeProtocolFromAutosend(shared_from_this());
 	Protocol::release();
 }
@@ -271,7 +312,6 @@ void ProtocolGame::login(const std::string& name, uint32_t accountId, OperatingS
 			connect(foundPlayer->getID(), operatingSystem);
 		}
 	}
-	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
 }
 
 void ProtocolGame::connect(uint32_t playerId, OperatingSystem_t operatingSystem)
@@ -358,7 +398,12 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage& msg)
 	OperatingSystem_t operatingSystem = static_cast<OperatingSystem_t>(msg.get<uint16_t>());
 	version = msg.get<uint16_t>();
 
-	if (!Protocol::RSA_decrypt(msg)) {
+	RSA_decryptAsync(msg, std::bind(&ProtocolGame::onFirstMessageDecrypted, getThis(), std::ref(msg), operatingSystem, std::placeholders::_1));
+}
+
+void ProtocolGame::onFirstMessageDecrypted(NetworkMessage& msg, OperatingSystem_t operatingSystem, bool decrypted)
+{
+	if (!decrypted) {
 		disconnect();
 		return;
 	}
@@ -459,13 +504,33 @@ void ProtocolGame::writeToOutputBuffer(const NetworkMessage& msg)
 	out->append(msg);
 }
 
-void ProtocolGame::parsePacket(NetworkMessage& msg)
+void ProtocolGame::sendBinaryOpcode(uint8_t opcode, const NetworkMessage& msg)
 {
-	g_dispatcher.addTask(createTask(std::bind(&ProtocolGame::parsePacketOnDispatcher, this, std::move(msg))));
+	auto out = getOutputBuffer(msg.getLength() + 4);
+	out->addByte(0x32);
+	out->addByte(opcode);
+	out->add<uint16_t>(msg.getLength());
+	out->append(msg);
 }
 
-void ProtocolGame::parsePacketOnDispatcher(NetworkMessage msg)
+void ProtocolGame::sendBinaryOpcode(uint8_t opcode, const NetworkMessageView& msg)
 {
+	auto out = getOutputBuffer(msg.getSize() + 4);
+	out->addByte(0x32);
+	out->addByte(opcode);
+	out->add<uint16_t>(msg.getSize());
+	out->append(msg.getData(), msg.getSize());
+}
+
+void ProtocolGame::parsePacket(const NetworkMessage_ptr& msg)
+{
+	++NetworkMessagePool::handedOff;
+	g_dispatcher.addTask(createTask(std::bind(&ProtocolGame::parsePacketOnDispatcher, this, msg)));
+}
+
+void ProtocolGame::parsePacketOnDispatcher(const NetworkMessage_ptr& msgPtr)
+{
+	NetworkMessage& msg = *msgPtr;
 	if (!acceptPackets || g_game.getGameState() == GAME_STATE_SHUTDOWN || msg.getLength() == 0) {
 		return;
 	}
@@ -602,6 +667,13 @@ void ProtocolGame::GetTileDescription(const Tile* tile, NetworkMessage& msg)
 		//msg.add<uint16_t>(0x00); //environmental effects
 	}
 
+	const CreatureVector* creatures = tile->getCreatures();
+	if (!creatures || creatures->empty()) {
+		const std::vector<uint8_t>& description = getTileItemsDescription(tile);
+		msg.addBytes(reinterpret_cast<const char*>(description.data()), description.size());
+		return;
+	}
+
 	int32_t count;
 	if (ground) {
 		msg.addItem(ground);
@@ -624,7 +696,6 @@ void ProtocolGame::GetTileDescription(const Tile* tile, NetworkMessage& msg)
 		}
 	}
 
-	const CreatureVector* creatures = tile->getCreatures();
 	if (creatures) {
 		bool playerAdded = false;
 		for (const Creature* creature : boost::adaptors::reverse(*creatures)) {
@@ -689,11 +760,12 @@ void ProtocolGame::GetMapDescription(int32_t x, int32_t y, int32_t z, int32_t wi
 
 void ProtocolGame::GetFloorDescription(NetworkMessage& msg, int32_t x, int32_t y, int32_t z, int32_t width, int32_t height, int32_t offset, int32_t& skip)
 {
+	const bool mapRefresh = g_config.getBoolean(ConfigManager::ENABLE_MAP_REFRESH);
 	for (int32_t nx = 0; nx < width; nx++) {
 		for (int32_t ny = 0; ny < height; ny++) {
 			Tile* tile = g_game.map.getTile(x + nx + offset, y + ny + offset, z);
 			if (tile) {
-				if (g_config.getBoolean(ConfigManager::ENABLE_MAP_REFRESH)) {
+				if (mapRefresh) {
 					tile->updateRefreshTime();
 				}
 
@@ -717,34 +789,20 @@ void ProtocolGame::GetFloorDescription(NetworkMessage& msg, int32_t x, int32_t y
 
 void ProtocolGame::checkCreatureAsKnown(uint32_t id, bool& known, uint32_t& removedKnown)
 {
-	auto result = knownCreatureSet.insert(id);
-	if (!result.second) {
+	if (knownCreatures.touch(id)) {
 		known = true;
 		return;
 	}
 
 	known = false;
 
-	if (knownCreatureSet.size() > 150) {
-		// Look for a creature to remove
-		for (auto it = knownCreatureSet.begin(), end = knownCreatureSet.end(); it != end; ++it) {
-			Creature* creature = g_game.getCreatureByID(*it);
-			if (!canSee(creature)) {
-				removedKnown = *it;
-				knownCreatureSet.erase(it);
-				return;
-			}
-		}
-
-		// Bad situation. Let's just remove anyone.
-		auto it = knownCreatureSet.begin();
-		if (*it == id) {
-			++it;
-		}
-
-		removedKnown = *it;
-		knownCreatureSet.erase(it);
+	if (knownCreatures.full()) {
+		// Prefer a creature the player can no longer see, otherwise remove the least recently used one
+		removedKnown = knownCreatures.replace(id, [this](uint32_t knownId) {
+			return !canSee(g_game.getCreatureByID(knownId));
+		});
 	} else {
+		knownCreatures.insert(id);
 		removedKnown = 0;
 	}
 }
@@ -1385,6 +1443,10 @@ void ProtocolGame::sendTextMessage(const TextMessage& message)
 
 void ProtocolGame::sendAnimatedText(const Position& pos, uint8_t color, const std::string& text)
 {
+	if (isBackpressured()) {
+		return;
+	}
+
 	NetworkMessage msg;
 	msg.addByte(0x84);
 	msg.addPosition(pos);
@@ -1396,6 +1458,10 @@ void ProtocolGame::sendAnimatedText(const Position& pos, uint8_t color, const st
 
 void ProtocolGame::sendAdvancedAnimatedText(const Position& pos, uint8_t color, const std::string& text, const std::string& font)
 {
+	if (isBackpressured()) {
+		return;
+	}
+
 	NetworkMessage msg;
 	msg.addByte(0x84);
 	msg.addPosition(pos);
@@ -1785,6 +1851,10 @@ void ProtocolGame::sendPingBack()
 
 void ProtocolGame::sendDistanceShoot(const Position& from, const Position& to, uint8_t type)
 {
+	if (isBackpressured()) {
+		return;
+	}
+
 	NetworkMessage msg;
 	msg.addByte(0x85);
 	msg.addPosition(from);
@@ -1795,7 +1865,7 @@ void ProtocolGame::sendDistanceShoot(const Position& from, const Position& to, u
 
 void ProtocolGame::sendMagicEffect(const Position& pos, uint8_t type)
 {
-	if (!canSee(pos)) {
+	if (!canSee(pos) || isBackpressured()) {
 		return;
 	}
 
@@ -1832,6 +1902,10 @@ void ProtocolGame::sendFYIBox(const std::string& message)
 //tile
 void ProtocolGame::sendMapDescription(const Position& pos)
 {
+#ifdef STATS_ENABLED
+	AutoStat stat("sendMapDescription");
+#endif
+
 	if (otclientV8) {
 		int32_t startz, endz, zstep;
 
@@ -2692,10 +2766,29 @@ void ProtocolGame::AddShopItem(NetworkMessage& msg, const ShopInfo& item)
 void ProtocolGame::parseExtendedOpcode(NetworkMessage& msg)
 {
 	uint8_t opcode = msg.getByte();
-	const std::string& buffer = msg.getString();
+	uint16_t size = msg.get<uint16_t>();
+	// same bound NetworkMessage::getString applies
+	if (msg.getBufferPosition() + size > msg.getLength() + 8 || size >= NETWORKMESSAGE_MAXSIZE - msg.getBufferPosition()) {
+		disconnect();
+		return;
+	}
+
+	if (opcode == EXTENDED_OPCODE_COMPRESSION) {
+		if (otclientV8 && !isCompressionEnabled() && g_config.getBoolean(ConfigManager::PACKET_COMPRESSION)) {
+			// compressed packets are flagged individually, so the reply itself may already be deflated
+			NetworkMessage reply;
+			reply.addByte(0x32);
+			reply.addByte(EXTENDED_OPCODE_COMPRESSION);
+			reply.addString("deflate");
+			writeToOutputBuffer(reply);
+			enableCompression();
+		}
+	} else {
+		// process additional opcodes via lua script event
+		g_game.parsePlayerExtendedOpcode(player->getID(), opcode, msg, size);
+	}
 
-	// process additional opcodes via lua script event
-	g_game.parsePlayerExtendedOpcode(player->getID(), opcode, buffer);
+	msg.skipBytes(size);
 }
 
 void ProtocolGame::parseNewWalking(NetworkMessage& msg)
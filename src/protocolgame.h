@@ -25,10 +25,12 @@
 #include "creature.h"
 #include "tasks.h"
 #include "battlepass.h"
+#include "knowncreatures.h"
 
 #include "walkmatrix.h"
 
 class NetworkMessage;
+class NetworkMessageView;
 class Player;
 class Game;
 class House;
@@ -77,6 +79,9 @@ class ProtocolGame final : public Protocol
 		void connect(uint32_t playerId, OperatingSystem_t operatingSystem);
 		void disconnectClient(const std::string& message) const;
 		void writeToOutputBuffer(const NetworkMessage& msg);
+		// extended opcode whose payload is appended straight from msg, no string in between
+		void sendBinaryOpcode(uint8_t opcode, const NetworkMessage& msg);
+		void sendBinaryOpcode(uint8_t opcode, const NetworkMessageView& msg);
 
 		void release() override;
 
@@ -87,9 +92,10 @@ class ProtocolGame final : public Protocol
 		bool canSee(const Position& pos) const;
 
 		// we have all the parse methods
-		void parsePacket(NetworkMessage& msg) override;
-		void parsePacketOnDispatcher(NetworkMessage msg) override;
+		void parsePacket(const NetworkMessage_ptr& msg) override;
+		void parsePacketOnDispatcher(const NetworkMessage_ptr& msgPtr) override;
 		void onRecvFirstMessage(NetworkMessage& msg) override;
+		void onFirstMessageDecrypted(NetworkMessage& msg, OperatingSystem_t operatingSystem, bool decrypted);
 
 		//Parse methods
 		void parseAutoWalk(NetworkMessage& msg);
@@ -292,7 +298,7 @@ class ProtocolGame final : public Protocol
 			g_dispatcher.addTask(createTaskWithStats(delay, std::bind(std::forward<Callable>(function), &g_game, std::forward<Args>(args)...), function_str, extra_info));
 		}
 
-		std::unordered_set<uint32_t> knownCreatureSet;
+		KnownCreatureTable knownCreatures;
 		Player* player = nullptr;
 
 		uint32_t eventConnect = 0;
@@ -138,7 +138,13 @@ void ProtocolLogin::onRecvFirstMessage(NetworkMessage& msg)
 		return;
 	}
 
-	if (!Protocol::RSA_decrypt(msg)) {
+	auto thisPtr = std::static_pointer_cast<ProtocolLogin>(shared_from_this());
+	RSA_decryptAsync(msg, std::bind(&ProtocolLogin::onFirstMessageDecrypted, thisPtr, std::ref(msg), version, std::placeholders::_1));
+}
+
+void ProtocolLogin::onFirstMessageDecrypted(NetworkMessage& msg, uint16_t version, bool decrypted)
+{
+	if (!decrypted) {
 		disconnect();
 		return;
 	}
@@ -41,6 +41,7 @@ class ProtocolLogin : public Protocol
 		void onRecvFirstMessage(NetworkMessage& msg) override;
 
 	private:
+		void onFirstMessageDecrypted(NetworkMessage& msg, uint16_t version, bool decrypted);
 		void disconnectClient(const std::string& message);
 
 		void getCharacterList(uint32_t accountNumber, const std::string& password);
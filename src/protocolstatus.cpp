@@ -27,7 +27,6 @@
 extern ConfigManager g_config;
 extern Game g_game;
 
-std::map<uint32_t, int64_t> ProtocolStatus::ipConnectMap;
 const uint64_t ProtocolStatus::start = OTSYS_TIME();
 
 enum RequestedInfo_t : uint16_t {
@@ -41,26 +40,99 @@ enum RequestedInfo_t : uint16_t {
 	REQUEST_SERVER_SOFTWARE_INFO = 1 << 7,
 };
 
-void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
+namespace {
+
+// responses are keyed by the requested info, the player status one is never cached
+constexpr uint16_t KNOWN_REQUESTED_INFO = 0xFF;
+constexpr uint32_t STATUS_STRING_KEY = KNOWN_REQUESTED_INFO + 1;
+
+struct CachedResponse {
+	std::shared_ptr<const std::string> data;
+	int64_t expiresAt = 0;
+};
+
+std::array<CachedResponse, STATUS_STRING_KEY + 1> responseCache;
+std::mutex responseCacheLock;
+
+std::shared_ptr<const std::string> getCachedResponse(uint32_t key)
 {
-	uint32_t ip = getIP();
-	if (ip != 0x0100007F) {
-		std::string ipStr = convertIPToString(ip);
-		if (ipStr != g_config.getString(ConfigManager::IP)) {
-			std::map<uint32_t, int64_t>::const_iterator it = ipConnectMap.find(ip);
-			if (it != ipConnectMap.end() && (OTSYS_TIME() < (it->second + g_config.getNumber(ConfigManager::STATUSQUERY_TIMEOUT)))) {
-				disconnect();
-				return;
+	std::lock_guard<std::mutex> lockClass(responseCacheLock);
+	const CachedResponse& cached = responseCache[key];
+	if (!cached.data || cached.expiresAt <= OTSYS_TIME()) {
+		return nullptr;
+	}
+	return cached.data;
+}
+
+void cacheResponse(uint32_t key, std::shared_ptr<const std::string> data)
+{
+	int64_t interval = g_config.getNumber(ConfigManager::STATUS_CACHE_INTERVAL);
+	if (interval <= 0) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lockClass(responseCacheLock);
+	responseCache[key] = {std::move(data), OTSYS_TIME() + interval};
+}
+
+// last status request of every IP, only touched by the network thread
+constexpr size_t MAX_STATUS_QUERY_IPS = 16384;
+std::unordered_map<uint32_t, int64_t> ipConnectMap;
+int64_t ipConnectMapPruned = 0;
+
+bool checkStatusQuery(uint32_t ip, bool throttled)
+{
+	int64_t now = OTSYS_TIME();
+	int64_t timeout = g_config.getNumber(ConfigManager::STATUSQUERY_TIMEOUT);
+	if (now - ipConnectMapPruned >= timeout) {
+		for (auto it = ipConnectMap.begin(); it != ipConnectMap.end(); ) {
+			if (now >= it->second + timeout) {
+				it = ipConnectMap.erase(it);
+			} else {
+				++it;
 			}
 		}
+		ipConnectMapPruned = now;
 	}
 
-	ipConnectMap[ip] = OTSYS_TIME();
+	auto it = ipConnectMap.find(ip);
+	if (it != ipConnectMap.end()) {
+		if (throttled && now < it->second + timeout) {
+			return false;
+		}
+		it->second = now;
+		return true;
+	}
+
+	// every entry is younger than the timeout, refuse new pollers instead of growing
+	if (ipConnectMap.size() >= MAX_STATUS_QUERY_IPS) {
+		return !throttled;
+	}
+
+	ipConnectMap.emplace(ip, now);
+	return true;
+}
+
+}
+
+void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
+{
+	uint32_t ip = getIP();
+	bool throttled = ip != 0x0100007F && convertIPToString(ip) != g_config.getString(ConfigManager::IP);
+	if (!checkStatusQuery(ip, throttled)) {
+		disconnect();
+		return;
+	}
 
 	switch (msg.getByte()) {
 		//XML info protocol
 		case 0xFF: {
 			if (msg.getString(4) == "info") {
+				if (auto data = getCachedResponse(STATUS_STRING_KEY)) {
+					sendResponse(*data, true);
+					return;
+				}
+
 				g_dispatcher.addTask(createTask(std::bind(&ProtocolStatus::sendStatusString,
 									  std::static_pointer_cast<ProtocolStatus>(shared_from_this()))));
 				return;
@@ -74,7 +146,11 @@ void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
 			std::string characterName;
 			if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
 				characterName = msg.getString();
+			} else if (auto data = getCachedResponse(requestedInfo & KNOWN_REQUESTED_INFO)) {
+				sendResponse(*data, false);
+				return;
 			}
+
 			g_dispatcher.addTask(createTask(std::bind(&ProtocolStatus::sendInfo, std::static_pointer_cast<ProtocolStatus>(shared_from_this()),
 								  requestedInfo, characterName)));
 			return;
@@ -88,10 +164,18 @@ void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
 
 void ProtocolStatus::sendStatusString()
 {
-	auto output = OutputMessagePool::getOutputMessage();
+	// another request may have refreshed the cache while this one was queued
+	auto data = getCachedResponse(STATUS_STRING_KEY);
+	if (!data) {
+		data = std::make_shared<const std::string>(buildStatusString());
+		cacheResponse(STATUS_STRING_KEY, data);
+	}
 
-	setRawMessages(true);
+	sendResponse(*data, true);
+}
 
+std::string ProtocolStatus::buildStatusString()
+{
 	pugi::xml_document doc;
 
 	pugi::xml_node decl = doc.prepend_child(pugi::node_declaration);
@@ -173,11 +257,7 @@ void ProtocolStatus::sendStatusString()
 
 	std::ostringstream ss;
 	doc.save(ss, "", pugi::format_raw);
-
-	std::string data = ss.str();
-	output->addBytes(data.c_str(), data.size());
-	send(output);
-	disconnect();
+	return ss.str();
 }
 
 void ProtocolStatus::sendInfo(uint16_t requestedInfo, const std::string& characterName)
@@ -248,6 +328,20 @@ void ProtocolStatus::sendInfo(uint16_t requestedInfo, const std::string& charact
 		output->addString(STATUS_SERVER_VERSION);
 		output->addString(CLIENT_VERSION_STR);
 	}
+
+	if (!(requestedInfo & REQUEST_PLAYER_STATUS_INFO)) {
+		cacheResponse(requestedInfo & KNOWN_REQUESTED_INFO, std::make_shared<const std::string>(
+			reinterpret_cast<const char*>(output->getBuffer()) + NetworkMessage::INITIAL_BUFFER_POSITION, output->getLength()));
+	}
+	send(output);
+	disconnect();
+}
+
+void ProtocolStatus::sendResponse(const std::string& data, bool raw)
+{
+	auto output = OutputMessagePool::getOutputMessage();
+	setRawMessages(raw);
+	output->addBytes(data.c_str(), data.size());
 	send(output);
 	disconnect();
 }
@@ -44,7 +44,9 @@ class ProtocolStatus final : public Protocol
 		static const uint64_t start;
 
 	private:
-		static std::map<uint32_t, int64_t> ipConnectMap;
+		static std::string buildStatusString();
+		// responses are cached for statusCacheInterval and served straight from the network thread
+		void sendResponse(const std::string& data, bool raw);
 };
 
 #endif
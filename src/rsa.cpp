@@ -32,8 +32,10 @@ static CryptoPP::AutoSeededRandomPool prng;
 void RSA::decrypt(char* msg) const
 {
 	try {
+		// called from the crypto workers, the random pool is not thread safe
+		thread_local CryptoPP::AutoSeededRandomPool threadPrng;
 		CryptoPP::Integer m{reinterpret_cast<uint8_t*>(msg), 128};
-		auto c = pk.CalculateInverse(prng, m);
+		auto c = pk.CalculateInverse(threadPrng, m);
 		c.Encode(reinterpret_cast<uint8_t*>(msg), 128);
 	} catch (const CryptoPP::Exception& e) {
 		std::cout << e.what() << '\n';
@@ -98,19 +98,23 @@ void ServicePort::accept()
 		return;
 	}
 
-	auto connection = ConnectionManager::getInstance().createConnection(io_service, shared_from_this());
-	acceptor->async_accept(connection->getSocket(), std::bind(&ServicePort::onAccept, shared_from_this(), connection, std::placeholders::_1));
+	acceptor->async_accept(io_service, std::bind(&ServicePort::onAccept, shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 }
 
-void ServicePort::onAccept(Connection_ptr connection, const boost::system::error_code& error)
+void ServicePort::onAccept(const boost::system::error_code& error, boost::asio::ip::tcp::socket socket)
 {
 	if (!error) {
 		if (services.empty()) {
 			return;
 		}
 
-		auto remote_ip = connection->getIP();
-		if (remote_ip != 0 && g_bans.acceptConnection(remote_ip)) {
+		// rejected sockets are closed before any connection state is allocated for them,
+		// the global budget is only charged for addresses within their own limit
+		boost::system::error_code endpointError;
+		const boost::asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(endpointError);
+		uint32_t remote_ip = endpointError ? 0 : htonl(endpoint.address().to_v4().to_ulong());
+		if (remote_ip != 0 && g_bans.acceptConnection(remote_ip) && g_bans.acceptNewConnection()) {
+			auto connection = ConnectionManager::getInstance().createConnection(io_service, shared_from_this(), std::move(socket));
 			Service_ptr service = services.front();
 			if (service->is_single_socket()) {
 				connection->accept(service->make_protocol(connection));
@@ -118,7 +122,8 @@ void ServicePort::onAccept(Connection_ptr connection, const boost::system::error
 				connection->accept();
 			}
 		} else {
-			connection->close(Connection::FORCE_CLOSE);
+			boost::system::error_code closeError;
+			socket.close(closeError);
 		}
 
 		accept();
@@ -36,10 +36,14 @@
 #include "monster.h"
 #include "events.h"
 #include "scheduler.h"
+#include "cryptotasks.h"
 #include "databasetasks.h"
+#include "filewritetasks.h"
 
 extern Scheduler g_scheduler;
 extern DatabaseTasks g_databaseTasks;
+extern CryptoTasks g_cryptoTasks;
+extern FileWriteTasks g_fileWriteTasks;
 extern Dispatcher g_dispatcher;
 
 extern ConfigManager g_config;
@@ -174,6 +178,8 @@ void dispatchSignalHandler(int signal)
 			// hold the thread until other threads end
 			g_scheduler.join();
 			g_databaseTasks.join();
+			g_cryptoTasks.join();
+			g_fileWriteTasks.join();
 			g_dispatcher.join();
 #ifdef STATS_ENABLED
 			g_stats.join();
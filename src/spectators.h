@@ -34,15 +34,7 @@ public:
 		vec.reserve(32);
 	}
 
-	void addSpectators(const SpectatorVec& spectators) {
-		for (Creature* spectator : spectators.vec) {
-			auto it = std::find(vec.begin(), vec.end(), spectator);
-			if (it != end()) {
-				continue;
-			}
-			vec.emplace_back(spectator);
-		}
-	}
+	void addSpectators(const SpectatorVec& spectators);
 
 	void erase(Creature* spectator) {
 		auto it = std::find(vec.begin(), vec.end(), spectator);
@@ -63,6 +55,9 @@ public:
 	void emplace_back(Creature* c) { vec.emplace_back(c); }
 
 private:
+	// bumped per merge, creatures already in the result carry the current value
+	static uint64_t epoch;
+
 	Vec vec;
 };
 
@@ -4,11 +4,16 @@
 #include <fstream>
 #include <iomanip>
 #include "configmanager.h"
+#include "ban.h"
+#include "connection.h"
+#include "game.h"
 #include "stats.h"
 #include "tasks.h"
 #include "tools.h"
 
 extern ConfigManager g_config;
+extern Ban g_bans;
+extern Game g_game;
 
 int64_t Stats::DUMP_INTERVAL = 30000; // 30 sec
 uint32_t Stats::SLOW_EXECUTION_TIME = 10000000; // 10 ms
@@ -19,7 +24,7 @@ AutoStatRecursive* AutoStatRecursive::activeStat = nullptr;
 void Stats::threadMain() {
 	std::unique_lock<std::mutex> taskLockUnique(statsLock, std::defer_lock);
 	bool last_iteration = false;
-	lua.lastDump = sql.lastDump = special.lastDump = OTSYS_TIME();
+	lua.lastDump = sql.lastDump = special.lastDump = networkLastDump = OTSYS_TIME();
 	playersOnline = 0;
 	for(auto& dispatcher : dispatchers) {
 		dispatcher.waitTime = 0;
@@ -90,6 +95,15 @@ void Stats::threadMain() {
 			special.lastDump = OTSYS_TIME();
 		}
 
+		if(networkLastDump + DUMP_INTERVAL < OTSYS_TIME() || last_iteration) {
+			writeNetworkStats("network.log");
+			writeSpectatorCacheStats("spectators.log");
+#ifdef STATS_ENABLED
+			writeWalkabilityStats("walkability.log");
+#endif
+			networkLastDump = OTSYS_TIME();
+		}
+
 		if(last_iteration)
 			break;
 		if(getState() == THREAD_STATE_TERMINATED) {
@@ -193,6 +207,94 @@ void Stats::writeSlowInfo(const std::string& file, uint64_t executionTime, const
 	out.close();
 }
 
+void Stats::writeNetworkStats(const std::string& file) {
+	auto& manager = ConnectionManager::getInstance();
+
+	std::array<uint32_t, ConnectionManager::QUEUE_DEPTH_BUCKETS> samples;
+	uint64_t total = 0;
+	size_t maxDepth = 0;
+	for (size_t depth = 0; depth < samples.size(); ++depth) {
+		samples[depth] = manager.queueDepthSamples[depth].exchange(0);
+		total += samples[depth];
+		if (samples[depth] != 0) {
+			maxDepth = depth;
+		}
+	}
+	uint32_t disconnects = manager.backpressureDisconnects.exchange(0);
+	uint64_t inboundPackets = NetworkMessagePool::handedOff.exchange(0);
+	uint64_t inboundAllocations = NetworkMessagePool::allocated.exchange(0);
+	uint32_t rejectedByIp = g_bans.rejectedByIp.exchange(0);
+	uint32_t rejectedGlobally = g_bans.rejectedGlobally.exchange(0);
+
+	if (DUMP_INTERVAL == 0 || (total == 0 && inboundPackets == 0 && rejectedByIp == 0 && rejectedGlobally == 0)) {
+		return;
+	}
+
+	auto percentile = [&](double p) {
+		uint64_t rank = static_cast<uint64_t>(std::ceil(p * total)), seen = 0;
+		for (size_t depth = 0; depth < samples.size(); ++depth) {
+			seen += samples[depth];
+			if (seen >= rank) {
+				return depth;
+			}
+		}
+		return maxDepth;
+	};
+
+	std::ofstream out(std::string("data/logs/stats/") + file, std::ofstream::out | std::ofstream::app);
+	if (!out.is_open()) {
+		std::clog << "Can't open " << std::string("data/logs/stats/") + file << " (check if directory exists)" << std::endl;
+		return;
+	}
+	out << "[" << formatDate(time(nullptr)) << "]\n";
+	out << "Send queue depth (" << total << " sends) p50: " << percentile(0.5) << " p90: " << percentile(0.9) << " p99: " << percentile(0.99)
+		<< " max: " << maxDepth << (maxDepth == samples.size() - 1 ? "+" : "") << "\n";
+	out << "Backpressured connections: " << manager.backpressuredConnections << " Disconnected for backpressure: " << disconnects << "\n";
+	// packets reach the dispatcher by pointer, the only bytes copied are the ones read from the socket
+	out << "Inbound packets: " << inboundPackets << " (" << inboundPackets * 1000 / DUMP_INTERVAL << "/s) buffers allocated: " << inboundAllocations << "\n";
+	out << "Rejected connections per IP: " << rejectedByIp << " over the global limit: " << rejectedGlobally << "\n\n";
+	out.flush();
+	out.close();
+}
+
+void Stats::writeSpectatorCacheStats(const std::string& file) {
+	uint64_t hits = g_game.map.spectatorCacheHits.exchange(0);
+	uint64_t misses = g_game.map.spectatorCacheMisses.exchange(0);
+	if (DUMP_INTERVAL == 0 || (hits + misses) == 0) {
+		return;
+	}
+
+	std::ofstream out(std::string("data/logs/stats/") + file, std::ofstream::out | std::ofstream::app);
+	if (!out.is_open()) {
+		std::clog << "Can't open " << std::string("data/logs/stats/") + file << " (check if directory exists)" << std::endl;
+		return;
+	}
+	out << "[" << formatDate(time(nullptr)) << "]\n";
+	out << "Spectator cache hits: " << hits << " misses: " << misses << " hit rate: " << (hits * 100 / (hits + misses)) << "%\n\n";
+	out.flush();
+	out.close();
+}
+
+#ifdef STATS_ENABLED
+void Stats::writeWalkabilityStats(const std::string& file) {
+	uint64_t hits = g_game.map.walkabilityBitmapHits.exchange(0);
+	uint64_t misses = g_game.map.walkabilityBitmapMisses.exchange(0);
+	if (DUMP_INTERVAL == 0 || (hits + misses) == 0) {
+		return;
+	}
+
+	std::ofstream out(std::string("data/logs/stats/") + file, std::ofstream::out | std::ofstream::app);
+	if (!out.is_open()) {
+		std::clog << "Can't open " << std::string("data/logs/stats/") + file << " (check if directory exists)" << std::endl;
+		return;
+	}
+	out << "[" << formatDate(time(nullptr)) << "]\n";
+	out << "Walkability bitmap hits: " << hits << " tile queries: " << misses << " hit rate: " << (hits * 100 / (hits + misses)) << "%\n\n";
+	out.flush();
+	out.close();
+}
+#endif
+
 void Stats::writeStats(const std::string& file, const statsMap& stats, const std::string& extraInfo) {
 	if (DUMP_INTERVAL == 0) {
 		return;
@@ -68,6 +68,11 @@ private:
 	void parseSpecialQueue(std::forward_list <Stat*>& queue);
 	static void writeSlowInfo(const std::string& file, uint64_t executionTime, const std::string& description, const std::string& extraDescription);
 	static void writeStats(const std::string& file, const statsMap& stats, const std::string& extraInfo = "");
+	static void writeNetworkStats(const std::string& file);
+	static void writeSpectatorCacheStats(const std::string& file);
+#ifdef STATS_ENABLED
+	static void writeWalkabilityStats(const std::string& file);
+#endif
 
 	std::mutex statsLock;
 	struct {
@@ -81,6 +86,7 @@ private:
 		statsMap stats;
 		int64_t lastDump;
 	} lua, sql, special;
+	int64_t networkLastDump;
 };
 
 extern Stats g_stats;
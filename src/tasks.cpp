@@ -21,6 +21,7 @@
 
 #include "tasks.h"
 #include "game.h"
+#include "outputmessage.h"
 
 extern Game g_game;
 
@@ -39,6 +40,7 @@ void Dispatcher::threadMain()
 	std::vector<Task*> tmpTaskList;
 	// NOTE: second argument defer_lock is to prevent from immediate locking
 	std::unique_lock<std::mutex> taskLockUnique(taskLock, std::defer_lock);
+	OutputMessagePool& outputMessagePool = OutputMessagePool::getInstance();
 
 #ifdef STATS_ENABLED
 	std::chrono::high_resolution_clock::time_point time_point;
@@ -75,8 +77,12 @@ void Dispatcher::threadMain()
 #else
 			delete task;
 #endif
+			outputMessagePool.sendExpired();
 		}
 		tmpTaskList.clear();
+
+		// end of the cycle, hand everything it produced to the network
+		outputMessagePool.sendAll();
 	}
 }
 
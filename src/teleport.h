@@ -44,6 +44,7 @@ class Teleport final : public Item, public Cylinder
 		}
 		void setDestPos(const Position& pos) {
 			destPos = pos;
+			invalidateTileCaches();
 		}
 
 		//cylinder implementations
@@ -409,6 +409,7 @@ Thing* Tile::getTopVisibleThing(const Creature* creature)
 void Tile::onAddTileItem(Item* item)
 {
 	setTileFlags(item);
+	invalidateDescription();
 
 	const Position& cylinderMapPos = getPosition();
 
@@ -425,6 +426,8 @@ void Tile::onAddTileItem(Item* item)
 
 void Tile::onUpdateTileItem(Item* oldItem, const ItemType& oldType, Item* newItem, const ItemType& newType)
 {
+	invalidateDescription();
+
 	const Position& cylinderMapPos = getPosition();
 
 	SpectatorVec spectators;
@@ -446,6 +449,7 @@ void Tile::onUpdateTileItem(Item* oldItem, const ItemType& oldType, Item* newIte
 void Tile::onRemoveTileItem(const SpectatorVec& spectators, const std::vector<int32_t>& oldStackPosVector, Item* item)
 {
 	resetTileFlags(item);
+	invalidateDescription();
 
 	const Position& cylinderMapPos = getPosition();
 	const ItemType& iType = Item::items[item->getID()];
@@ -900,10 +904,7 @@ void Tile::addThing(int32_t, Thing* thing)
 {
 	Creature* creature = thing->getCreature();
 	if (creature) {
-		g_game.map.clearSpectatorCache();
-		if (creature->getPlayer()) {
-			g_game.map.clearPlayersSpectatorCache();
-		}
+		g_game.map.clearSpectatorCache(getPosition(), creature->getPlayer() != nullptr);
 
 		creature->setParent(this);
 		CreatureVector* creatures = makeCreatures();
@@ -925,6 +926,7 @@ void Tile::addThing(int32_t, Thing* thing)
 		if (itemType.isGroundTile()) {
 			if (ground == nullptr) {
 				ground = item;
+				updateWalkability();
 				onAddTileItem(item);
 			} else {
 				const ItemType& oldType = Item::items[ground->getID()];
@@ -935,6 +937,7 @@ void Tile::addThing(int32_t, Thing* thing)
 				ground = item;
 				resetTileFlags(oldGround);
 				setTileFlags(item);
+				updateWalkability();
 				onUpdateTileItem(oldGround, oldType, item, itemType);
 				postRemoveNotification(oldGround, nullptr, 0);
 			}
@@ -1040,6 +1043,9 @@ void Tile::updateThing(Thing* thing, uint16_t itemId, uint32_t count)
 	item->setID(itemId);
 	item->setSubType(count);
 	setTileFlags(item);
+	if (item == ground) {
+		updateWalkability();
+	}
 	onUpdateTileItem(item, oldType, item, newType);
 }
 
@@ -1106,6 +1112,9 @@ void Tile::replaceThing(uint32_t index, Thing* thing)
 
 		resetTileFlags(oldItem);
 		setTileFlags(item);
+		if (item == ground) {
+			updateWalkability();
+		}
 		const ItemType& oldType = Item::items[oldItem->getID()];
 		const ItemType& newType = Item::items[item->getID()];
 		onUpdateTileItem(oldItem, oldType, item, newType);
@@ -1123,10 +1132,7 @@ void Tile::removeThing(Thing* thing, uint32_t count)
 		if (creatures) {
 			auto it = std::find(creatures->begin(), creatures->end(), thing);
 			if (it != creatures->end()) {
-				g_game.map.clearSpectatorCache();
-				if (creature->getPlayer()) {
-					g_game.map.clearPlayersSpectatorCache();
-				}
+				g_game.map.clearSpectatorCache(getPosition(), creature->getPlayer() != nullptr);
 
 				creatures->erase(it);
 			}
@@ -1147,6 +1153,7 @@ void Tile::removeThing(Thing* thing, uint32_t count)
 	if (item == ground) {
 		ground->setParent(nullptr);
 		ground = nullptr;
+		updateWalkability();
 
 		SpectatorVec spectators;
 		g_game.map.getSpectators(spectators, getPosition(), true);
@@ -1342,6 +1349,23 @@ int32_t Tile::getStackposOfItem(const Player* player, const Item* item) const
 	return -1;
 }
 
+const std::vector<uint8_t>& Tile::setCachedDescription(const uint8_t* bytes, size_t size) const
+{
+	if (!descriptionCache) {
+		descriptionCache.reset(new DescriptionCache());
+	}
+
+	descriptionCache->version = version;
+	descriptionCache->bytes.assign(bytes, bytes + size);
+	return descriptionCache->bytes;
+}
+
+const std::string& Tile::setCachedSaveRecord(std::string&& record) const
+{
+	saveRecord.reset(new std::string(std::move(record)));
+	return *saveRecord;
+}
+
 void Tile::updateRefreshTime()
 {
 	nextRefreshTime = OTSYS_TIME() + g_config.getNumber(ConfigManager::MAP_REFRESH_VISIBILITY_INTERVAL);
@@ -1498,10 +1522,7 @@ void Tile::internalAddThing(uint32_t, Thing* thing)
 
 	Creature* creature = thing->getCreature();
 	if (creature) {
-		g_game.map.clearSpectatorCache();
-		if (creature->getPlayer()) {
-			g_game.map.clearPlayersSpectatorCache();
-		}
+		g_game.map.clearSpectatorCache(getPosition(), creature->getPlayer() != nullptr);
 
 		CreatureVector* creatures = makeCreatures();
 		creatures->insert(creatures->end(), creature);
@@ -1511,11 +1532,14 @@ void Tile::internalAddThing(uint32_t, Thing* thing)
 			return;
 		}
 
+		invalidateDescription();
+
 		const ItemType& itemType = Item::items[item->getID()];
 		if (itemType.isGroundTile()) {
 			if (ground == nullptr) {
 				ground = item;
 				setTileFlags(item);
+				updateWalkability();
 			}
 			return;
 		}
@@ -1608,6 +1632,11 @@ void Tile::setTileFlags(const Item* item)
 	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
 		setFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
+
+	// the flag covers the items above the ground, the ground's own property is read directly
+	if (item != ground && item->hasProperty(CONST_PROP_BLOCKPROJECTILE)) {
+		setFlag(TILESTATE_BLOCKPROJECTILE);
+	}
 }
 
 void Tile::resetTileFlags(const Item* item)
@@ -1674,6 +1703,18 @@ void Tile::resetTileFlags(const Item* item)
 	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
 		resetFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
+
+	if (item != ground && item->hasProperty(CONST_PROP_BLOCKPROJECTILE)) {
+		const TileItemVector* items = getItemList();
+		if (!items || std::none_of(items->begin(), items->end(), [item](const Item* tileItem) { return tileItem != item && tileItem->hasProperty(CONST_PROP_BLOCKPROJECTILE); })) {
+			resetFlag(TILESTATE_BLOCKPROJECTILE);
+		}
+	}
+}
+
+void Tile::updateWalkability() const
+{
+	g_game.map.updateWalkability(this);
 }
 
 bool Tile::isMoveableBlocking() const
@@ -65,8 +65,16 @@ enum tileflags_t : uint32_t {
 	TILESTATE_NOFIELDBLOCKPATH = 1 << 23,
 	TILESTATE_SUPPORTS_HANGABLE = 1 << 24,
 	TILESTATE_SPECIALFIELDBLOCKPATH = 1 << 25,
+	TILESTATE_BLOCKPROJECTILE = 1 << 26,
 
 	TILESTATE_FLOORCHANGE = TILESTATE_FLOORCHANGE_DOWN | TILESTATE_FLOORCHANGE_NORTH | TILESTATE_FLOORCHANGE_SOUTH | TILESTATE_FLOORCHANGE_EAST | TILESTATE_FLOORCHANGE_WEST | TILESTATE_FLOORCHANGE_SOUTH_ALT | TILESTATE_FLOORCHANGE_EAST_ALT,
+
+	// tiles with any of these are never entered by pathfinding, the second set only applies to monsters
+	TILESTATE_PATHFINDING_BLOCKED = TILESTATE_FLOORCHANGE | TILESTATE_TELEPORT | TILESTATE_SPECIALFIELDBLOCKPATH,
+	TILESTATE_MONSTER_BLOCKED = TILESTATE_PATHFINDING_BLOCKED | TILESTATE_PROTECTIONZONE | TILESTATE_IMMOVABLEBLOCKSOLID | TILESTATE_IMMOVABLENOFIELDBLOCKPATH,
+
+	// changes to any of these are mirrored into the map floor bitmaps
+	TILESTATE_FLOOR_BITMAPS = TILESTATE_MONSTER_BLOCKED | TILESTATE_BLOCKPROJECTILE,
 };
 
 enum ZoneType_t {
@@ -220,6 +228,7 @@ class Tile : public Cylinder
 
 		void setFlags(uint32_t flags) {
 			this->flags = flags;
+			updateWalkability();
 		}
 		uint32_t getFlags() const {
 			return this->flags;
@@ -229,9 +238,15 @@ class Tile : public Cylinder
 		}
 		void setFlag(uint32_t flag) {
 			this->flags |= flag;
+			if (hasBitSet(TILESTATE_FLOOR_BITMAPS, flag)) {
+				updateWalkability();
+			}
 		}
 		void resetFlag(uint32_t flag) {
 			this->flags &= ~flag;
+			if (hasBitSet(TILESTATE_FLOOR_BITMAPS, flag)) {
+				updateWalkability();
+			}
 		}
 
 		ZoneType_t getZone() const {
@@ -260,6 +275,31 @@ class Tile : public Cylinder
 			return nextRefreshTime;
 		}
 
+		// bumped whenever an item on the tile changes, invalidates the cached client description
+		uint32_t getVersion() const {
+			return version;
+		}
+		void invalidateDescription() {
+			++version;
+			invalidateSaveRecord();
+		}
+		const std::vector<uint8_t>* getCachedDescription() const {
+			if (!descriptionCache || descriptionCache->version != version) {
+				return nullptr;
+			}
+			return &descriptionCache->bytes;
+		}
+		const std::vector<uint8_t>& setCachedDescription(const uint8_t* bytes, size_t size) const;
+
+		// serialized live map record of the tile, dropped whenever anything stored in it changes
+		const std::string* getCachedSaveRecord() const {
+			return saveRecord.get();
+		}
+		const std::string& setCachedSaveRecord(std::string&& record) const;
+		virtual void invalidateSaveRecord() {
+			saveRecord.reset();
+		}
+
 		//cylinder implementations
 		ReturnValue queryAdd(int32_t index, const Thing& thing, uint32_t count,
 				uint32_t flags, Creature* actor = nullptr) const override;
@@ -305,6 +345,8 @@ class Tile : public Cylinder
 		}
 		void setGround(Item* item) {
 			ground = item;
+			invalidateDescription();
+			updateWalkability();
 		}
 
 	private:
@@ -315,11 +357,27 @@ class Tile : public Cylinder
 
 		void setTileFlags(const Item* item);
 		void resetTileFlags(const Item* item);
+		void updateWalkability() const;
+
+		struct DescriptionCache {
+			uint32_t version;
+			std::vector<uint8_t> bytes;
+		};
 
 		Item* ground = nullptr;
+		mutable std::unique_ptr<DescriptionCache> descriptionCache;
+		mutable std::unique_ptr<std::string> saveRecord;
 		Position tilePos;
 		uint32_t flags = 0;
+		uint32_t version = 0;
 		int64_t nextRefreshTime = 0;
+
+		// position of the tile in Game::tilesToRefresh and Game::tilesToSave, maintained by Game
+		static constexpr uint32_t UNLISTED = std::numeric_limits<uint32_t>::max();
+		uint32_t refreshListIndex = UNLISTED;
+		uint32_t saveListIndex = UNLISTED;
+
+		friend class Game;
 };
 
 // Used for walkable tiles, where there is high likeliness of